@@ -0,0 +1,71 @@
+#include <SpriteDesc.hpp>
+#include <ecsps/AtlasPacker.hpp>
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <map>
+
+int main(int argc, char **argv)
+{
+    using namespace ecsps;
+
+    if (argc < 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <sprites> <output directory> [page size]" << std::endl;
+        return 1;
+    }
+
+    std::string outputDir = argv[2];
+    int pageSize = argc > 3 ? std::stoi(argv[3]) : 2048;
+    auto spriteDescs = loadSpriteDescs(argv[1]);
+
+    std::map<std::string, std::size_t> imageIndices;
+    std::vector<sf::Image> images;
+    std::vector<vec2i> sizes;
+    for (auto& desc : spriteDescs)
+    {
+        if (!imageIndices.insert({desc.second.texture, images.size()}).second)
+            continue;
+        images.emplace_back();
+        if (!images.back().loadFromFile(desc.second.texture))
+        {
+            std::cerr << "cannot load " << desc.second.texture << std::endl;
+            return 1;
+        }
+        auto size = images.back().getSize();
+        sizes.push_back(vec2i(int(size.x), int(size.y)));
+    }
+
+    auto placements = packAtlas(sizes, vec2i(pageSize, pageSize));
+
+    unsigned pageCount = 0;
+    for (auto& placement : placements)
+        pageCount = std::max(pageCount, placement.page + 1);
+
+    std::vector<sf::Image> pages(pageCount);
+    for (auto& page : pages)
+        page.create(pageSize, pageSize, sf::Color::Transparent);
+    for (std::size_t i = 0; i < images.size(); ++i)
+        pages[placements[i].page].copy(images[i], placements[i].position[0], placements[i].position[1]);
+
+    std::vector<std::string> pageFiles;
+    for (unsigned i = 0; i < pageCount; ++i)
+    {
+        pageFiles.push_back(outputDir + "/page_" + std::to_string(i) + ".png");
+        if (!pages[i].saveToFile(pageFiles.back()))
+        {
+            std::cerr << "cannot save " << pageFiles.back() << std::endl;
+            return 1;
+        }
+    }
+
+    for (auto& desc : spriteDescs)
+    {
+        auto index = imageIndices.at(desc.second.texture);
+        desc.second.texture = pageFiles[placements[index].page];
+        desc.second.texturePosition = placements[index].position;
+        desc.second.size = sizes[index];
+    }
+    saveSpriteDescs(outputDir + "/sprites", spriteDescs);
+
+    std::cout << images.size() << " images packed into " << pageCount << " pages" << std::endl;
+}
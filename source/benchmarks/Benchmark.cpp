@@ -0,0 +1,224 @@
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace ecsps
+{
+namespace benchmark
+{
+
+namespace
+{
+
+struct Options
+{
+    std::string filter;
+    unsigned repetitions = 5;
+    double minTime = 0.1;
+    std::string format = "console";
+    std::string out;
+};
+
+struct Result
+{
+    std::string name;
+    std::uint64_t iterations;
+    std::vector<double> nanoseconds;
+    double itemsPerSecond;
+    double mean, median, stddev, min;
+};
+
+std::vector<std::unique_ptr<Benchmark>>& benchmarks()
+{
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+bool option(const std::string& arg, const std::string& name, std::string& value)
+{
+    auto prefix = "--" + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0)
+        return false;
+    value = arg.substr(prefix.size());
+    return true;
+}
+
+Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i], value;
+        if (option(arg, "filter", value))
+            options.filter = value;
+        else if (option(arg, "repetitions", value))
+            options.repetitions = std::max(1, std::stoi(value));
+        else if (option(arg, "min-time", value))
+            options.minTime = std::stod(value);
+        else if (option(arg, "format", value))
+            options.format = value;
+        else if (option(arg, "out", value))
+            options.out = value;
+        else
+            throw std::invalid_argument("unknown option: " + arg + "\nusage: ecsps_benchmarks [--filter=substring] [--repetitions=N] [--min-time=seconds] [--format=console|json] [--out=file]");
+    }
+    if (options.format != "console" && options.format != "json")
+        throw std::invalid_argument("unknown format: " + options.format);
+    return options;
+}
+
+std::string fullName(const Benchmark& benchmark, const std::vector<long>& args)
+{
+    std::string name = benchmark.getName();
+    for (auto arg : args)
+        name += "/" + std::to_string(arg);
+    return name;
+}
+
+Result run(const std::string& name, const Function& function, const std::vector<long>& args, const Options& options)
+{
+    std::uint64_t iterations = 1;
+    for (;;)
+    {
+        State state{iterations, args};
+        function(state);
+        auto seconds = state.seconds();
+        if (seconds >= options.minTime || iterations >= 1000000000)
+            break;
+        auto scale = seconds > 0 ? options.minTime * 1.4 / seconds : 10.0;
+        iterations = std::max(iterations + 1, std::uint64_t(iterations * std::min(scale, 10.0)));
+    }
+
+    Result result{name, iterations, {}, 0, 0, 0, 0, 0};
+    double items = 0, seconds = 0;
+    for (unsigned repetition = 0; repetition < options.repetitions; ++repetition)
+    {
+        State state{iterations, args};
+        function(state);
+        result.nanoseconds.push_back(state.seconds() * 1e9 / iterations);
+        items += state.items();
+        seconds += state.seconds();
+    }
+
+    auto sorted = result.nanoseconds;
+    std::sort(begin(sorted), end(sorted));
+    auto count = sorted.size();
+    for (auto ns : sorted)
+        result.mean += ns / count;
+    result.median = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+    for (auto ns : sorted)
+        result.stddev += (ns - result.mean) * (ns - result.mean);
+    result.stddev = count > 1 ? std::sqrt(result.stddev / (count - 1)) : 0;
+    result.min = sorted.front();
+    result.itemsPerSecond = seconds > 0 ? items / seconds : 0;
+    return result;
+}
+
+void printConsole(std::ostream& os, const Result& result)
+{
+    os << std::left << std::setw(48) << result.name << std::right
+       << std::setw(14) << std::fixed << std::setprecision(1) << result.mean << " ns"
+       << std::setw(14) << result.median << " ns"
+       << std::setw(8) << std::setprecision(1) << (result.mean > 0 ? result.stddev * 100 / result.mean : 0) << " %"
+       << std::setw(14) << result.iterations;
+    if (result.itemsPerSecond > 0)
+        os << std::setw(14) << std::setprecision(3) << std::scientific << result.itemsPerSecond << " items/s";
+    os << std::endl;
+}
+
+std::string escape(const std::string& text)
+{
+    std::string escaped;
+    for (auto c : text)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+void printJson(std::ostream& os, const std::vector<Result>& results, const Options& options)
+{
+    char date[32];
+    auto now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << std::setprecision(17) << "{\n"
+       << "  \"context\": {\"date\": \"" << date << "\", \"repetitions\": " << options.repetitions << ", \"min_time\": " << options.minTime << "},\n"
+       << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        auto& result = results[i];
+        os << (i ? "," : "") << "\n    {\"name\": \"" << escape(result.name) << "\", \"iterations\": " << result.iterations
+           << ", \"mean_ns\": " << result.mean << ", \"median_ns\": " << result.median
+           << ", \"stddev_ns\": " << result.stddev << ", \"min_ns\": " << result.min
+           << ", \"items_per_second\": " << result.itemsPerSecond << ", \"repetitions_ns\": [";
+        for (std::size_t r = 0; r < result.nanoseconds.size(); ++r)
+            os << (r ? ", " : "") << result.nanoseconds[r];
+        os << "]}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+}
+
+Benchmark& registerBenchmark(std::string name, Function function)
+{
+    benchmarks().push_back(std::make_unique<Benchmark>(std::move(name), std::move(function)));
+    return *benchmarks().back();
+}
+
+int runBenchmarks(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    bool console = options.format == "console";
+    if (console)
+        std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(17) << "mean" << std::setw(17) << "median" << std::setw(10) << "cv" << std::setw(14) << "iterations" << std::endl;
+
+    std::vector<Result> results;
+    for (auto& benchmark : benchmarks())
+    {
+        auto argSets = benchmark->getArgs();
+        if (argSets.empty())
+            argSets.emplace_back();
+        for (auto& args : argSets)
+        {
+            auto name = fullName(*benchmark, args);
+            if (name.find(options.filter) == std::string::npos)
+                continue;
+            results.push_back(run(name, benchmark->getFunction(), args, options));
+            if (console)
+                printConsole(std::cout, results.back());
+        }
+    }
+
+    if (!console)
+        printJson(std::cout, results, options);
+    if (!options.out.empty())
+    {
+        std::ofstream out(options.out);
+        printJson(out, results, options);
+    }
+    return 0;
+}
+
+}
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ecsps
+{
+namespace benchmark
+{
+
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+class State
+{
+public:
+    State(std::uint64_t iterations, std::vector<long> args) : iterations(iterations), remaining(iterations), args(std::move(args)) { }
+
+    bool keepRunning()
+    {
+        if (remaining == iterations && !running)
+            resumeTiming();
+        if (remaining > 0)
+        {
+            --remaining;
+            return true;
+        }
+        pauseTiming();
+        return false;
+    }
+
+    void pauseTiming()
+    {
+        if (!running)
+            return;
+        elapsed += Clock::now() - start;
+        running = false;
+    }
+
+    void resumeTiming()
+    {
+        start = Clock::now();
+        running = true;
+    }
+
+    long range(std::size_t index) const { return args.at(index); }
+    std::uint64_t maxIterations() const { return iterations; }
+
+    void setItemsProcessed(std::uint64_t items) { itemsProcessed = items; }
+    std::uint64_t items() const { return itemsProcessed; }
+
+    double seconds() const { return std::chrono::duration<double>(elapsed).count(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::uint64_t iterations;
+    std::uint64_t remaining;
+    std::vector<long> args;
+    std::uint64_t itemsProcessed = 0;
+    bool running = false;
+    Clock::time_point start;
+    Clock::duration elapsed{0};
+};
+
+using Function = std::function<void(State&)>;
+
+class Benchmark
+{
+public:
+    Benchmark(std::string name, Function function) : name(std::move(name)), function(std::move(function)) { }
+
+    Benchmark& arg(long value) { return args({value}); }
+    Benchmark& args(std::vector<long> values)
+    {
+        argSets.push_back(std::move(values));
+        return *this;
+    }
+    Benchmark& ranges(const std::vector<std::vector<long>>& values)
+    {
+        std::vector<std::vector<long>> product{{}};
+        for (auto& range : values)
+        {
+            std::vector<std::vector<long>> next;
+            for (auto& prefix : product)
+                for (auto value : range)
+                {
+                    next.push_back(prefix);
+                    next.back().push_back(value);
+                }
+            product = std::move(next);
+        }
+        for (auto& args : product)
+            argSets.push_back(std::move(args));
+        return *this;
+    }
+
+    const std::string& getName() const { return name; }
+    const Function& getFunction() const { return function; }
+    const std::vector<std::vector<long>>& getArgs() const { return argSets; }
+
+private:
+    std::string name;
+    Function function;
+    std::vector<std::vector<long>> argSets;
+};
+
+Benchmark& registerBenchmark(std::string name, Function function);
+int runBenchmarks(int argc, char **argv);
+
+}
+}
+
+#define ECSPS_BENCHMARK_CONCAT2(a, b) a##b
+#define ECSPS_BENCHMARK_CONCAT(a, b) ECSPS_BENCHMARK_CONCAT2(a, b)
+#define ECSPS_BENCHMARK_NAMED(name, ...) \
+    static ::ecsps::benchmark::Benchmark& ECSPS_BENCHMARK_CONCAT(benchmark_, __LINE__) = \
+        ::ecsps::benchmark::registerBenchmark(name, __VA_ARGS__)
+#define ECSPS_BENCHMARK(...) ECSPS_BENCHMARK_NAMED(#__VA_ARGS__, __VA_ARGS__)
@@ -6,6 +6,7 @@
 #include <map>
 #include <unordered_map>
 #include <array>
+#include <algorithm>
 
 using ElementType = unsigned;
 
@@ -0,0 +1,121 @@
+#include "Benchmark.hpp"
+#include <ecsps/EntitySystem.hpp>
+#include <memory>
+#include <utility>
+
+namespace ecsps
+{
+namespace
+{
+
+using benchmark::State;
+using benchmark::doNotOptimize;
+
+template <int N>
+struct Component
+{
+    float value = 1;
+};
+
+using Entities = EntitySystem<Component<0>, Component<1>, Component<2>, Component<3>, Component<4>, Component<5>, Component<6>, Component<7>>;
+
+template <typename... Cs>
+void touch(Cs&... cs)
+{
+    int values[] = {0, (cs.value += 1, 0)...};
+    (void)values;
+}
+
+template <typename... Cs>
+float sum(const Cs&... cs)
+{
+    float total = 0;
+    int values[] = {0, (total += cs.value, 0)...};
+    (void)values;
+    return total;
+}
+
+template <std::size_t... Is>
+void populate(Entities& es, long count, long percent, std::index_sequence<Is...>)
+{
+    for (long i = 0; i < count; ++i)
+        if (i * percent % 100 < percent)
+            es.createEntity(Component<int(Is)>{}...);
+        else
+            es.createEntity(Component<sizeof...(Is) == 1 ? 1 : 0>{});
+}
+
+template <std::size_t... Is>
+void createEntities(State& state, std::index_sequence<Is...>)
+{
+    auto count = state.range(0);
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        auto es = std::make_unique<Entities>();
+        state.resumeTiming();
+        for (long i = 0; i < count; ++i)
+            doNotOptimize(es->createEntity(Component<int(Is)>{}...));
+        state.pauseTiming();
+        es.reset();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.maxIterations() * count);
+}
+
+template <std::size_t... Is>
+void queryEntities(State& state, std::index_sequence<Is...> components)
+{
+    Entities es;
+    populate(es, state.range(0), state.range(1), components);
+    const Entities& view = es;
+    view.query<Component<int(Is)>...>()([](const auto&...) { });
+    while (state.keepRunning())
+    {
+        float total = 0;
+        view.query<Component<int(Is)>...>()([&](const auto&... cs) { total += sum(cs...); });
+        doNotOptimize(total);
+    }
+    state.setItemsProcessed(state.maxIterations() * state.range(0));
+}
+
+template <std::size_t... Is>
+void modifyEntities(State& state, std::index_sequence<Is...> components)
+{
+    Entities es;
+    populate(es, state.range(0), state.range(1), components);
+    es.modify<Component<int(Is)>...>()([](auto&...) { });
+    while (state.keepRunning())
+    {
+        es.modify<Component<int(Is)>...>()([](auto&... cs) { touch(cs...); });
+        benchmark::clobberMemory();
+    }
+    state.setItemsProcessed(state.maxIterations() * state.range(0));
+}
+
+template <std::size_t N>
+void create(State& state) { createEntities(state, std::make_index_sequence<N>()); }
+
+template <std::size_t N>
+void query(State& state) { queryEntities(state, std::make_index_sequence<N>()); }
+
+template <std::size_t N>
+void modify(State& state) { modifyEntities(state, std::make_index_sequence<N>()); }
+
+ECSPS_BENCHMARK(create<1>).ranges({{1000, 100000}});
+ECSPS_BENCHMARK(create<2>).ranges({{1000, 100000}});
+ECSPS_BENCHMARK(create<4>).ranges({{1000, 100000}});
+ECSPS_BENCHMARK(create<8>).ranges({{1000, 100000}});
+
+ECSPS_BENCHMARK(query<1>).ranges({{1000, 100000}, {100, 10}});
+ECSPS_BENCHMARK(query<2>).ranges({{1000, 100000}, {100, 10}});
+ECSPS_BENCHMARK(query<4>).ranges({{1000, 100000}, {100, 10}});
+ECSPS_BENCHMARK(query<8>).ranges({{1000, 100000}, {100, 10}});
+
+ECSPS_BENCHMARK(modify<1>).ranges({{1000, 100000}, {100, 10}});
+ECSPS_BENCHMARK(modify<2>).ranges({{1000, 100000}, {100, 10}});
+ECSPS_BENCHMARK(modify<4>).ranges({{1000, 100000}, {100, 10}});
+ECSPS_BENCHMARK(modify<8>).ranges({{1000, 100000}, {100, 10}});
+
+}
+}
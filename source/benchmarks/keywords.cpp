@@ -0,0 +1,84 @@
+#include "Benchmark.hpp"
+#include <ecsps/KeywordMap.hpp>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ecsps
+{
+namespace
+{
+
+using benchmark::State;
+using benchmark::doNotOptimize;
+
+struct SpriteLike
+{
+    float x, y, w, h;
+};
+
+std::vector<Keyword> keywords(long count)
+{
+    std::vector<Keyword> names;
+    for (long i = 0; i < count; ++i)
+        names.emplace_back("sprite_" + std::to_string(count) + "_" + std::to_string(i));
+    return names;
+}
+
+void keywordConstruction(State& state)
+{
+    std::vector<std::string> names;
+    for (auto& keyword : keywords(256))
+        names.push_back(keyword.str());
+    std::size_t i = 0;
+    while (state.keepRunning())
+        doNotOptimize(Keyword(names[i++ % names.size()]));
+}
+
+void keywordLiteral(State& state)
+{
+    while (state.keepRunning())
+        doNotOptimize("keyword_literal"_k);
+}
+
+void keywordComparison(State& state)
+{
+    auto names = keywords(256);
+    std::size_t i = 0;
+    while (state.keepRunning())
+    {
+        doNotOptimize(names[i % names.size()] == names[(i * 7) % names.size()]);
+        ++i;
+    }
+}
+
+template <typename Map>
+void keywordLookup(State& state)
+{
+    auto names = keywords(state.range(0));
+    Map map;
+    for (auto& key : names)
+        map.insert({key, SpriteLike{1, 2, 3, 4}});
+    std::vector<Keyword> probes;
+    for (unsigned i = 0; i < 4096; ++i)
+        probes.push_back(names[std::rand() % names.size()]);
+
+    while (state.keepRunning())
+    {
+        float sum = 0;
+        for (auto& key : probes)
+            sum += map.at(key).w;
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.maxIterations() * probes.size());
+}
+
+ECSPS_BENCHMARK(keywordConstruction);
+ECSPS_BENCHMARK(keywordLiteral);
+ECSPS_BENCHMARK(keywordComparison);
+ECSPS_BENCHMARK_NAMED("keywordLookup<unordered_map>", keywordLookup<std::unordered_map<Keyword, SpriteLike>>).ranges({{16, 256, 4096}});
+ECSPS_BENCHMARK_NAMED("keywordLookup<KeywordMap>", keywordLookup<KeywordMap<SpriteLike>>).ranges({{16, 256, 4096}});
+
+}
+}
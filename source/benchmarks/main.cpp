@@ -0,0 +1,6 @@
+#include "Benchmark.hpp"
+
+int main(int argc, char **argv)
+{
+    return ecsps::benchmark::runBenchmarks(argc, argv);
+}
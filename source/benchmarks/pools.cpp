@@ -0,0 +1,139 @@
+#include "Benchmark.hpp"
+#include <ecsps/ValuePool.hpp>
+#include <ecsps/ResourcePool.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ecsps
+{
+namespace
+{
+
+using benchmark::State;
+using benchmark::doNotOptimize;
+
+template <typename Value>
+class SingleLockPool
+{
+public:
+    std::shared_ptr<const Value> get(const Value& value)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto found = pool.find(value);
+        if (found != end(pool))
+            if (auto ptr = found->second.lock())
+                return ptr;
+        auto ptr = std::make_shared<const Value>(value);
+        pool[value] = ptr;
+        return ptr;
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<Value, std::weak_ptr<const Value>> pool;
+};
+
+class Barrier
+{
+public:
+    explicit Barrier(unsigned count) : count(count) { }
+
+    void arriveAndWait()
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        auto current = generation;
+        if (++arrived == count)
+        {
+            arrived = 0;
+            ++generation;
+            released.notify_all();
+            return;
+        }
+        released.wait(lock, [&] { return generation != current; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    unsigned count;
+    unsigned arrived = 0;
+    std::uint64_t generation = 0;
+};
+
+const unsigned keyCount = 1024;
+const unsigned lookupsPerThread = 16 * keyCount;
+
+template <typename Get>
+void contention(State& state, Get get)
+{
+    auto threadCount = unsigned(state.range(0));
+    std::vector<std::shared_ptr<const std::string>> held;
+    for (unsigned i = 0; i < keyCount; ++i)
+        held.push_back(get(std::to_string(i)));
+
+    std::vector<std::vector<std::string>> keys(threadCount);
+    for (unsigned t = 0; t < threadCount; ++t)
+        for (unsigned i = 0; i < keyCount; ++i)
+            keys[t].push_back(std::to_string((i * 7919 + t * 31) % keyCount));
+
+    Barrier start{threadCount + 1}, finish{threadCount + 1};
+    bool stopping = false;
+    std::vector<std::thread> threads;
+    for (auto& threadKeys : keys)
+        threads.emplace_back([&]
+        {
+            while (true)
+            {
+                start.arriveAndWait();
+                if (stopping)
+                    return;
+                for (unsigned n = 0; n < lookupsPerThread; ++n)
+                    doNotOptimize(get(threadKeys[n % keyCount]));
+                finish.arriveAndWait();
+            }
+        });
+
+    while (state.keepRunning())
+    {
+        start.arriveAndWait();
+        finish.arriveAndWait();
+    }
+
+    stopping = true;
+    start.arriveAndWait();
+    for (auto& thread : threads)
+        thread.join();
+    state.setItemsProcessed(state.maxIterations() * threadCount * lookupsPerThread);
+}
+
+void singleLockPool(State& state)
+{
+    auto pool = std::make_shared<SingleLockPool<std::string>>();
+    contention(state, [&](const std::string& key) { return pool->get(key); });
+}
+
+void valuePool(State& state)
+{
+    auto pool = std::make_shared<ValuePool<std::string>>();
+    contention(state, [&](const std::string& key) { return pool->get(key); });
+}
+
+void resourcePool(State& state)
+{
+    using Resources = ResourcePool<std::string, std::string>;
+    auto pool = std::make_shared<Resources>([](const std::string& id) { return std::unique_ptr<const std::string>(new std::string(id)); });
+    contention(state, [&](const std::string& key) { return pool->get(key); });
+}
+
+ECSPS_BENCHMARK(singleLockPool).ranges({{1, 2, 4, 8}});
+ECSPS_BENCHMARK(valuePool).ranges({{1, 2, 4, 8}});
+ECSPS_BENCHMARK(resourcePool).ranges({{1, 2, 4, 8}});
+
+}
+}
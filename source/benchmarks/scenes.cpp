@@ -0,0 +1,91 @@
+#include "Benchmark.hpp"
+#include "Level.hpp"
+#include "SceneGenerator.hpp"
+#include "Simulation.hpp"
+#include "SnapshotTraits.hpp"
+#include <ecsps/EntitySystem.hpp>
+#include <ecsps/Scheduler.hpp>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace ecsps
+{
+namespace
+{
+
+using benchmark::State;
+
+void generate(State& state)
+{
+    SceneConfig config;
+    config.tiles = state.range(0);
+    config.characters = state.range(1);
+    config.sparsity = state.range(2) / 100.0f;
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        auto entitySystem = std::make_unique<SimulationComponents<EntitySystem>>();
+        state.resumeTiming();
+        generateScene(*entitySystem, config);
+        state.pauseTiming();
+        entitySystem.reset();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.maxIterations() * (config.tiles + config.characters));
+}
+
+void restore(State& state)
+{
+    SceneConfig config;
+    config.tiles = state.range(0);
+    config.characters = state.range(1);
+    config.sparsity = state.range(2) / 100.0f;
+    std::string path = "ecsps_benchmark.snapshot";
+    {
+        SimulationComponents<EntitySystem> entitySystem;
+        generateScene(entitySystem, config);
+        saveSnapshot(entitySystem, path);
+    }
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        auto entitySystem = std::make_unique<SimulationComponents<EntitySystem>>();
+        state.resumeTiming();
+        loadSnapshot(*entitySystem, path);
+        state.pauseTiming();
+        entitySystem.reset();
+        state.resumeTiming();
+    }
+    std::remove(path.c_str());
+    state.setItemsProcessed(state.maxIterations() * (config.tiles + config.characters));
+}
+
+void simulate(State& state)
+{
+    SceneConfig config;
+    config.tiles = state.range(0);
+    config.characters = state.range(1);
+    config.sparsity = state.range(2) / 100.0f;
+    SimulationComponents<EntitySystem> entitySystem;
+    generateScene(entitySystem, config);
+
+    auto threadPool = std::make_shared<ThreadPool>();
+    Simulation simulation{threadPool, characterAnimations()};
+    const float delta = 1.0f / 60;
+    SimulationComponents<Scheduler> schedule{threadPool};
+    simulation.schedule(schedule, entitySystem, delta);
+    simulation.input().moveRight(true);
+    schedule.run();
+
+    while (state.keepRunning())
+        schedule.run();
+    state.setItemsProcessed(state.maxIterations() * config.characters);
+}
+
+ECSPS_BENCHMARK(generate).ranges({{1000, 10000}, {100, 1000}, {0, 50}});
+ECSPS_BENCHMARK(restore).ranges({{1000, 10000}, {100, 1000}, {0, 50}});
+ECSPS_BENCHMARK(simulate).ranges({{1000, 10000}, {100, 1000}, {0, 50}});
+
+}
+}
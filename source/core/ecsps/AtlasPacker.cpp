@@ -0,0 +1,42 @@
+#include "AtlasPacker.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace ecsps
+{
+
+std::vector<AtlasPlacement> packAtlas(const std::vector<vec2i>& sizes, const vec2i& pageSize, int padding)
+{
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(begin(order), end(order), 0);
+    std::stable_sort(begin(order), end(order), [&](auto left, auto right) { return sizes[left][1] > sizes[right][1]; });
+
+    std::vector<AtlasPlacement> placements(sizes.size());
+    unsigned page = 0;
+    int x = 0, y = 0, shelfHeight = 0;
+    for (auto index : order)
+    {
+        auto width = sizes[index][0], height = sizes[index][1];
+        if (width > pageSize[0] || height > pageSize[1])
+            throw std::invalid_argument("ecsps::packAtlas: image does not fit in a page");
+
+        if (x + width > pageSize[0])
+        {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (y + height > pageSize[1])
+        {
+            ++page;
+            x = y = shelfHeight = 0;
+        }
+        placements[index] = {page, vec2i(x, y)};
+        x += width + padding;
+        shelfHeight = std::max(shelfHeight, height + padding);
+    }
+    return placements;
+}
+
+}
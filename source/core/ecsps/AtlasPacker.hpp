@@ -0,0 +1,16 @@
+#pragma once
+#include "Math.hpp"
+#include <vector>
+
+namespace ecsps
+{
+
+struct AtlasPlacement
+{
+    unsigned page;
+    vec2i position;
+};
+
+std::vector<AtlasPlacement> packAtlas(const std::vector<vec2i>& sizes, const vec2i& pageSize, int padding = 1);
+
+}
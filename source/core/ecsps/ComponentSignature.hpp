@@ -0,0 +1,42 @@
+#pragma once
+#include <bitset>
+#include <cstddef>
+#include <type_traits>
+
+namespace ecsps
+{
+
+template <typename Component, typename... AllComponents>
+struct ComponentIndex;
+
+template <typename Component, typename... AllComponents>
+struct ComponentIndex<Component, Component, AllComponents...> : std::integral_constant<std::size_t, 0> { };
+
+template <typename Component, typename Other, typename... AllComponents>
+struct ComponentIndex<Component, Other, AllComponents...>
+    : std::integral_constant<std::size_t, 1 + ComponentIndex<Component, AllComponents...>::value> { };
+
+template <typename... AllComponents>
+struct ComponentSignature
+{
+    using type = std::bitset<sizeof...(AllComponents)>;
+
+    template <typename Component>
+    static constexpr std::size_t index() { return ComponentIndex<Component, AllComponents...>::value; }
+
+    template <typename... Components>
+    static type of()
+    {
+        type signature;
+        int expand[] = {0, (signature.set(index<Components>()), 0)...};
+        (void)expand;
+        return signature;
+    }
+
+    static bool contains(const type& signature, const type& mask)
+    {
+        return (signature & mask) == mask;
+    }
+};
+
+}
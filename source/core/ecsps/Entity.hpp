@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace ecsps
+{
+
+struct Entity
+{
+    using Index = std::uint32_t;
+    using Generation = std::uint32_t;
+
+    static constexpr Index invalidIndex = std::numeric_limits<Index>::max();
+
+    Index index = invalidIndex;
+    Generation generation = 0;
+
+    Entity() = default;
+    Entity(Index index, Generation generation) : index(index), generation(generation) { }
+
+    friend bool operator==(const Entity& left, const Entity& right)
+    {
+        return left.index == right.index && left.generation == right.generation;
+    }
+};
+
+inline bool operator!=(const Entity& left, const Entity& right)
+{
+    return !(left == right);
+}
+
+}
+
+namespace std
+{
+
+template<>
+struct hash<ecsps::Entity>
+{
+    using argument_type = ecsps::Entity;
+    using result_type = std::size_t;
+    result_type operator()(argument_type const& e) const
+    {
+        return std::hash<std::uint64_t>()((std::uint64_t(e.generation) << 32) | e.index);
+    }
+};
+
+}
@@ -1,22 +1,147 @@
 #pragma once
-#include <unordered_map>
-#include <typeindex>
+#include "ComponentSignature.hpp"
+#include "Entity.hpp"
+#include "Profiler.hpp"
+#include "SparsePool.hpp"
+#include "ThreadPool.hpp"
+#include "WriteScope.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <vector>
 
 namespace ecsps
 {
 
+struct SnapshotAccess;
+
 template <typename... AllComponents>
 class EntitySystem
 {
+    struct Group;
+    friend struct SnapshotAccess;
+
 public:
+    struct QueryPlan
+    {
+        std::size_t driverComponent;
+        std::size_t candidateCount;
+    };
+
+    template <bool Const, typename... EntityComponents>
+    class View
+    {
+    public:
+        template <typename F>
+        void operator()(F f) const
+        {
+            ECSPS_PROFILE_SCOPE("EntitySystem::View");
+            if (!Const)
+                es->template touch<EntityComponents...>();
+            for (auto index : group->entities)
+                f(es->template pool<EntityComponents>().get(index)...);
+        }
+
+        std::size_t size() const { return group->entities.size(); }
+
+    private:
+        friend class EntitySystem;
+        using Owner = typename std::conditional<Const, const EntitySystem, EntitySystem>::type;
+
+        View(Owner& es, const Group& group) : es(&es), group(&group) { }
+
+        Owner *es;
+        const Group *group;
+    };
+
     template <typename... EntityComponents>
-    void createEntity(EntityComponents&&... components)
+    Entity createEntity(EntityComponents&&... components)
     {
-        Entity entity;
+        Entity entity = allocateEntity();
         addComponents(entity, std::forward<EntityComponents>(components)...);
-        entities.push_back(std::move(entity));
+        return entity;
+    }
+
+    void destroyEntity(Entity entity)
+    {
+        if (!alive(entity))
+            return;
+        int expand[] = {0, (pool<AllComponents>().erase(entity.index), 0)...};
+        (void)expand;
+        auto& slot = slots[entity.index];
+        updateGroups(entity.index, slot.signature, {});
+        slot.signature.reset();
+        ++slot.generation;
+        freeIndices.push_back(entity.index);
+    }
+
+    bool alive(Entity entity) const
+    {
+        return entity.index < slots.size() && slots[entity.index].generation == entity.generation;
+    }
+
+    template <typename... EntityComponents>
+    void addComponents(Entity entity, EntityComponents&&... cs)
+    {
+        checkAlive(entity);
+        auto& signature = slots[entity.index].signature;
+        auto previous = signature;
+        int expand[] = {0, (pool<strip<EntityComponents>>().insert(entity.index, std::forward<EntityComponents>(cs)), 0)...};
+        (void)expand;
+        signature |= Signature::template of<strip<EntityComponents>...>();
+        updateGroups(entity.index, previous, signature, previous & Signature::template of<strip<EntityComponents>...>());
+    }
+
+    template <typename... EntityComponents>
+    void removeComponents(Entity entity)
+    {
+        checkAlive(entity);
+        auto& signature = slots[entity.index].signature;
+        auto previous = signature;
+        int expand[] = {0, (pool<EntityComponents>().erase(entity.index), 0)...};
+        (void)expand;
+        signature &= ~Signature::template of<EntityComponents...>();
+        updateGroups(entity.index, previous, signature);
+    }
+
+    template <typename... EntityComponents>
+    bool has(Entity entity) const
+    {
+        return alive(entity) && Signature::contains(slots[entity.index].signature, Signature::template of<EntityComponents...>());
+    }
+
+    template <typename EntityComponent>
+    EntityComponent& get(Entity entity)
+    {
+        checkHas<EntityComponent>(entity);
+        return pool<EntityComponent>().get(entity.index);
+    }
+
+    template <typename EntityComponent>
+    const EntityComponent& get(Entity entity) const
+    {
+        checkHas<EntityComponent>(entity);
+        return pool<EntityComponent>().get(entity.index);
+    }
+
+    template <typename EntityComponent>
+    EntityComponent *find(Entity entity)
+    {
+        return alive(entity) && pool<EntityComponent>().contains(entity.index) ? &pool<EntityComponent>().get(entity.index) : nullptr;
+    }
+
+    template <typename EntityComponent>
+    const EntityComponent *find(Entity entity) const
+    {
+        return alive(entity) && pool<EntityComponent>().contains(entity.index) ? &pool<EntityComponent>().get(entity.index) : nullptr;
     }
 
     template <typename... EntityComponents>
@@ -24,9 +149,8 @@ public:
     {
         return [this](auto f)
         {
-            for (auto& entity : entities)
-                if (entity.template hasComponents<EntityComponents...>())
-                    f(std::get<std::vector<EntityComponents>>(components).at(entity.template getComponentIndex<EntityComponents>())...);
+            ECSPS_PROFILE_SCOPE("EntitySystem::query");
+            each<const EntityComponents...>(*this, f);
         };
     }
 
@@ -35,52 +159,324 @@ public:
     {
         return [this](auto f)
         {
-            for (auto& entity : entities)
-                if (entity.template hasComponents<EntityComponents...>())
-                    f(std::get<std::vector<EntityComponents>>(components).at(entity.template getComponentIndex<EntityComponents>())...);
+            ECSPS_PROFILE_SCOPE("EntitySystem::modify");
+            touch<EntityComponents...>();
+            each<EntityComponents...>(*this, f);
+        };
+    }
+
+    template <typename... EntityComponents>
+    auto queryEntities() const
+    {
+        return [this](auto f)
+        {
+            ECSPS_PROFILE_SCOPE("EntitySystem::queryEntities");
+            for (auto index : entityIndices<EntityComponents...>())
+                f(Entity{index, slots[index].generation}, pool<EntityComponents>().get(index)...);
+        };
+    }
+
+    template <typename... EntityComponents>
+    auto parallelModify(ThreadPool& threadPool, std::size_t grainSize = 1024)
+    {
+        return [this, &threadPool, grainSize](auto f)
+        {
+            ECSPS_PROFILE_SCOPE("EntitySystem::parallelModify");
+            touch<EntityComponents...>();
+            parallelEach<EntityComponents...>(threadPool, grainSize, f, std::integral_constant<bool, sizeof...(EntityComponents) == 1>{});
         };
     }
 
+    template <typename... EntityComponents>
+    View<true, EntityComponents...> view() const
+    {
+        return {*this, group<EntityComponents...>()};
+    }
+
+    template <typename... EntityComponents>
+    View<false, EntityComponents...> view()
+    {
+        return {*this, group<EntityComponents...>()};
+    }
+
+    // Changes when entities join or leave the query or when its components are written through
+    // modify(), parallelModify() or a mutable view of it or a broader query; get() is not tracked.
+    template <typename... EntityComponents>
+    std::uint64_t version() const
+    {
+        auto& group = this->group<EntityComponents...>();
+        return group.membership + group.contents;
+    }
+
+    template <typename... EntityComponents>
+    std::uint64_t membershipVersion() const
+    {
+        return group<EntityComponents...>().membership;
+    }
+
+    std::uint64_t loadEpoch() const { return epoch; }
+
+    template <typename EntityComponent>
+    static constexpr std::size_t componentIndex() { return Signature::template index<strip<EntityComponent>>(); }
+
+    template <typename EntityComponent>
+    QueryPlan queryPlan() const
+    {
+        return {componentIndex<EntityComponent>(), pool<EntityComponent>().size()};
+    }
+
+    template <typename EntityComponent, typename EntityComponent2, typename... EntityComponents>
+    QueryPlan queryPlan() const
+    {
+        auto& group = this->group<EntityComponent, EntityComponent2, EntityComponents...>();
+        return {group.driver, group.entities.size()};
+    }
+
 private:
     template <typename T>
     using strip = typename std::remove_const<typename std::remove_reference<T>::type>::type;
 
-    struct Entity
+    using Signature = ComponentSignature<AllComponents...>;
+
+    struct Slot
+    {
+        typename Signature::type signature;
+        Entity::Generation generation = 0;
+    };
+
+    struct Group
     {
-        std::unordered_map<std::type_index, std::ptrdiff_t> components;
+        typename Signature::type mask;
+        std::size_t driver = 0;
+        std::vector<Entity::Index> entities;
+        std::vector<Entity::Index> positions;
+        std::atomic<std::uint64_t> membership{0};
+        std::atomic<std::uint64_t> contents{0};
+
+        explicit Group(typename Signature::type mask) : mask(mask) { }
 
-        template <typename Component, typename Component2, typename... Components>
-        bool hasComponents() const
+        void insert(Entity::Index index)
         {
-            return hasComponents<Component>() && hasComponents<Component2, Components...>();
+            if (index >= positions.size())
+                positions.resize(index + 1, Entity::Index(Entity::invalidIndex));
+            positions[index] = Entity::Index(entities.size());
+            entities.push_back(index);
+            ++membership;
         }
 
-        template <typename Component>
-        bool hasComponents() const
+        void erase(Entity::Index index)
         {
-            return components.find(std::type_index(typeid(Component))) != end(components);
+            auto position = positions[index];
+            entities[position] = entities.back();
+            positions[entities[position]] = position;
+            entities.pop_back();
+            positions[index] = Entity::invalidIndex;
+            ++membership;
         }
+    };
+
+    struct Binding
+    {
+        Group *group = nullptr;
+        typename Signature::type written;
+        std::vector<Group *> touched;
+    };
 
-        template <typename Component>
-        auto getComponentIndex() const
+    Entity allocateEntity()
+    {
+        if (freeIndices.empty())
         {
-            return components.at(std::type_index(typeid(Component)));
+            slots.emplace_back();
+            return {Entity::Index(slots.size() - 1), 0};
         }
-    };
+        auto index = freeIndices.back();
+        freeIndices.pop_back();
+        return {index, slots[index].generation};
+    }
 
-    void addComponents(Entity& entity) { }
+    void checkAlive(Entity entity) const
+    {
+        if (!alive(entity))
+            throw std::out_of_range("ecsps::EntitySystem: stale entity handle");
+    }
 
-    template <typename EntityComponent, typename... EntityComponents>
-    void addComponents(Entity& entity, EntityComponent&& c, EntityComponents&&... cs)
+    template <typename EntityComponent>
+    void checkHas(Entity entity) const
     {
-        auto& container = std::get<std::vector<strip<EntityComponent>>>(components);
-        container.push_back(std::forward<EntityComponent>(c));
-        entity.components[std::type_index(typeid(EntityComponent))] = container.size() - 1;
-        addComponents(entity, std::forward<EntityComponents>(cs)...);
+        checkAlive(entity);
+        if (!pool<EntityComponent>().contains(entity.index))
+            throw std::out_of_range("ecsps::EntitySystem: entity has no such component");
     }
 
-    std::tuple<std::vector<AllComponents>...> components;
-    std::vector<Entity> entities;
+    template <typename Component>
+    auto& pool() { return std::get<SparsePool<strip<Component>, Entity::Index>>(pools); }
+
+    template <typename Component>
+    auto& pool() const { return std::get<SparsePool<strip<Component>, Entity::Index>>(pools); }
+
+    static std::atomic<std::size_t>& nextBindingSlot()
+    {
+        static std::atomic<std::size_t> next{0};
+        return next;
+    }
+
+    template <typename... EntityComponents>
+    static typename Signature::type writtenMask()
+    {
+        typename Signature::type mask;
+        int expand[] = {0, (std::is_const<EntityComponents>::value ? 0 : (mask.set(Signature::template index<strip<EntityComponents>>()), 0))...};
+        (void)expand;
+        return mask;
+    }
+
+    template <typename... EntityComponents>
+    const Binding& binding() const
+    {
+        static const std::size_t slot = nextBindingSlot()++;
+        auto table = bindings.load(std::memory_order_acquire);
+        if (table && slot < table->size() && (*table)[slot].group)
+            return (*table)[slot];
+        return createBinding<EntityComponents...>(slot);
+    }
+
+    template <typename... EntityComponents>
+    const Group& group() const
+    {
+        return *binding<EntityComponents...>().group;
+    }
+
+    template <typename... EntityComponents>
+    void touch() const
+    {
+#ifndef NDEBUG
+        bool declared[] = {true, (std::is_const<EntityComponents>::value || WriteScope::allows(typeid(strip<EntityComponents>)))...};
+        assert(std::all_of(std::begin(declared), std::end(declared), [](bool d) { return d; }) && "component written outside of the running system's Writes<>");
+#endif
+        for (auto group : binding<EntityComponents...>().touched)
+            group->contents.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename... EntityComponents>
+    const Binding& createBinding(std::size_t slot) const
+    {
+        std::lock_guard<std::mutex> lock{groupsMutex};
+        auto current = bindings.load(std::memory_order_relaxed);
+        if (current && slot < current->size() && (*current)[slot].group)
+            return (*current)[slot];
+
+        auto mask = Signature::template of<strip<EntityComponents>...>();
+        auto found = std::find_if(begin(groups), end(groups), [&](auto& group) { return group->mask == mask; });
+        Group *group = found != end(groups) ? found->get() : nullptr;
+        if (!group)
+        {
+            groups.push_back(std::make_unique<Group>(mask));
+            group = groups.back().get();
+            std::array<const std::vector<Entity::Index> *, sizeof...(EntityComponents)> candidates{{&pool<EntityComponents>().entityIndices()...}};
+            std::array<std::size_t, sizeof...(EntityComponents)> components{{componentIndex<EntityComponents>()...}};
+            auto driver = std::min_element(begin(candidates), end(candidates), [](auto left, auto right) { return left->size() < right->size(); }) - begin(candidates);
+            group->driver = components[driver];
+            for (auto index : *candidates[driver])
+                if (Signature::contains(slots[index].signature, mask))
+                    group->insert(index);
+        }
+
+        auto table = std::make_unique<BindingTable>(current ? *current : BindingTable{});
+        if (slot >= table->size())
+            table->resize(slot + 1);
+        (*table)[slot].group = group;
+        (*table)[slot].written = writtenMask<EntityComponents...>();
+        for (auto& binding : *table)
+        {
+            binding.touched.clear();
+            if (binding.group)
+                for (auto& other : groups)
+                    if ((other->mask & binding.written).any() && Signature::contains(other->mask, binding.group->mask))
+                        binding.touched.push_back(other.get());
+        }
+        bindings.store(table.get(), std::memory_order_release);
+        bindingTables.push_back(std::move(table));
+        return (*bindingTables.back())[slot];
+    }
+
+    template <typename EntityComponent>
+    const std::vector<Entity::Index>& entityIndices() const
+    {
+        return pool<EntityComponent>().entityIndices();
+    }
+
+    template <typename EntityComponent, typename EntityComponent2, typename... EntityComponents>
+    const std::vector<Entity::Index>& entityIndices() const
+    {
+        return group<EntityComponent, EntityComponent2, EntityComponents...>().entities;
+    }
+
+    void updateGroups(Entity::Index index, const typename Signature::type& previous, const typename Signature::type& current, const typename Signature::type& replaced = {})
+    {
+        for (auto& group : groups)
+        {
+            bool was = Signature::contains(previous, group->mask);
+            bool is = Signature::contains(current, group->mask);
+            if (is && !was)
+                group->insert(index);
+            else if (was && !is)
+                group->erase(index);
+            else if (is && (group->mask & replaced).any())
+                ++group->contents;
+        }
+    }
+
+    template <typename... EntityComponents, typename Self, typename F>
+    static void each(Self& self, F& f)
+    {
+        each<EntityComponents...>(self, f, std::integral_constant<bool, sizeof...(EntityComponents) == 1>{});
+    }
+
+    template <typename EntityComponent, typename Self, typename F>
+    static void each(Self& self, F& f, std::true_type)
+    {
+        for (auto& component : self.template pool<EntityComponent>())
+            f(component);
+    }
+
+    template <typename... EntityComponents, typename Self, typename F>
+    static void each(Self& self, F& f, std::false_type)
+    {
+        for (auto index : self.template group<EntityComponents...>().entities)
+            f(self.template pool<EntityComponents>().get(index)...);
+    }
+
+    template <typename EntityComponent, typename F>
+    void parallelEach(ThreadPool& threadPool, std::size_t grainSize, F& f, std::true_type)
+    {
+        auto components = pool<EntityComponent>().data();
+        threadPool.parallelFor(pool<EntityComponent>().size(), grainSize, [&](std::size_t first, std::size_t last)
+        {
+            for (auto i = first; i != last; ++i)
+                f(components[i]);
+        });
+    }
+
+    template <typename... EntityComponents, typename F>
+    void parallelEach(ThreadPool& threadPool, std::size_t grainSize, F& f, std::false_type)
+    {
+        auto& entities = group<EntityComponents...>().entities;
+        threadPool.parallelFor(entities.size(), grainSize, [&](std::size_t first, std::size_t last)
+        {
+            for (auto i = first; i != last; ++i)
+                f(pool<EntityComponents>().get(entities[i])...);
+        });
+    }
+
+    std::tuple<SparsePool<AllComponents, Entity::Index>...> pools;
+    std::vector<Slot> slots;
+    std::vector<Entity::Index> freeIndices;
+    std::uint64_t epoch = 0;
+    using BindingTable = std::vector<Binding>;
+
+    mutable std::mutex groupsMutex;
+    mutable std::vector<std::unique_ptr<Group>> groups;
+    mutable std::atomic<const BindingTable *> bindings{nullptr};
+    mutable std::vector<std::unique_ptr<const BindingTable>> bindingTables;
 };
 
 }
@@ -0,0 +1,37 @@
+#pragma once
+
+namespace ecsps
+{
+
+class FixedTimestep
+{
+public:
+    FixedTimestep(float step, unsigned maxStepsPerAdvance)
+        : stepSize(step), maxStepsPerAdvance(maxStepsPerAdvance) { }
+
+    template <typename F>
+    unsigned advance(float elapsed, F simulate)
+    {
+        accumulator += elapsed;
+        unsigned steps = 0;
+        while (accumulator >= stepSize && steps < maxStepsPerAdvance)
+        {
+            simulate(stepSize);
+            accumulator -= stepSize;
+            ++steps;
+        }
+        if (accumulator >= stepSize)
+            accumulator = 0;
+        return steps;
+    }
+
+    float step() const { return stepSize; }
+    float alpha() const { return accumulator / stepSize; }
+
+private:
+    float stepSize;
+    unsigned maxStepsPerAdvance;
+    float accumulator = 0;
+};
+
+}
@@ -0,0 +1,90 @@
+#include "InputRecording.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace ecsps
+{
+
+namespace
+{
+
+const std::string header = "ecsps-input 2";
+const std::string scenePrefix = "scene ";
+
+}
+
+void InputRecording::record(std::uint64_t step, Buttons buttons)
+{
+    if (step < steps)
+        throw std::invalid_argument("ecsps::InputRecording: steps must be recorded in order");
+    if (changes.empty() ? buttons != 0 : changes.back().buttons != buttons)
+        changes.push_back({step, buttons});
+    steps = step + 1;
+}
+
+InputRecording::Buttons InputRecording::at(std::uint64_t step) const
+{
+    auto next = std::upper_bound(begin(changes), end(changes), step, [](std::uint64_t step, const Change& change) { return step < change.step; });
+    return next == begin(changes) ? 0 : std::prev(next)->buttons;
+}
+
+void InputRecording::setScene(std::string scene)
+{
+    if (scene.find('\n') != std::string::npos)
+        throw std::invalid_argument("ecsps::InputRecording: scene ids must fit on one line");
+    sceneId = std::move(scene);
+}
+
+void InputRecording::checkScene(const std::string& scene) const
+{
+    if (scene != sceneId)
+        throw std::runtime_error("ecsps::InputRecording: recorded for scene '" + sceneId + "', not '" + scene + "'");
+}
+
+void InputRecording::save(std::ostream& os) const
+{
+    os << header << '\n';
+    os << scenePrefix << sceneId << '\n';
+    for (auto& change : changes)
+        os << change.step << ' ' << change.buttons << '\n';
+    os << "end " << steps << '\n';
+}
+
+InputRecording InputRecording::load(std::istream& is)
+{
+    std::string line;
+    if (!std::getline(is, line) || line != header)
+        throw std::runtime_error("ecsps::InputRecording: not an input recording");
+    if (!std::getline(is, line) || line.compare(0, scenePrefix.size(), scenePrefix) != 0)
+        throw std::runtime_error("ecsps::InputRecording: corrupt recording");
+
+    InputRecording recording;
+    recording.sceneId = line.substr(scenePrefix.size());
+    std::string word;
+    while (is >> word)
+    {
+        if (word == "end")
+        {
+            std::uint64_t steps;
+            if (!(is >> steps) || steps < recording.steps)
+                throw std::runtime_error("ecsps::InputRecording: corrupt recording");
+            recording.steps = steps;
+            return recording;
+        }
+        Buttons buttons;
+        if (!(is >> buttons))
+            throw std::runtime_error("ecsps::InputRecording: corrupt recording");
+        try
+        {
+            recording.record(std::stoull(word), buttons);
+        }
+        catch (const std::logic_error& )
+        {
+            throw std::runtime_error("ecsps::InputRecording: corrupt recording");
+        }
+    }
+    throw std::runtime_error("ecsps::InputRecording: truncated recording");
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ecsps
+{
+
+class InputRecording
+{
+public:
+    using Buttons = std::uint32_t;
+
+    void record(std::uint64_t step, Buttons buttons);
+    Buttons at(std::uint64_t step) const;
+
+    std::uint64_t length() const { return steps; }
+    std::size_t changeCount() const { return changes.size(); }
+
+    void setScene(std::string scene);
+    const std::string& scene() const { return sceneId; }
+    void checkScene(const std::string& scene) const;
+
+    void save(std::ostream& os) const;
+    static InputRecording load(std::istream& is);
+
+private:
+    struct Change
+    {
+        std::uint64_t step;
+        Buttons buttons;
+    };
+
+    std::vector<Change> changes;
+    std::uint64_t steps = 0;
+    std::string sceneId;
+};
+
+}
@@ -1,13 +1,153 @@
 #include "Keyword.hpp"
-#include "ValuePool.hpp"
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace ecsps
 {
 
-Keyword::Keyword(const std::string& name)
+namespace
 {
-    static auto pool = std::make_shared<ValuePool<std::string>>();
-    this->name = pool->get(name);
+
+class SymbolTable
+{
+public:
+    SymbolTable()
+    {
+        for (auto& segment : segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+        intern(std::string{});
+    }
+
+    ~SymbolTable()
+    {
+        for (auto& segment : segments)
+            delete[] segment.load(std::memory_order_relaxed);
+    }
+
+    Keyword::Id intern(const std::string& name)
+    {
+        auto& shard = shards[std::hash<std::string>()(name) % shardCount];
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        auto found = shard.ids.find(name);
+        if (found != end(shard.ids))
+            return found->second;
+        auto id = append(name);
+        shard.ids.insert({name, id});
+        return id;
+    }
+
+    const std::string& str(Keyword::Id id) const
+    {
+        auto segment = segmentOf(id);
+        return segments[segment].load(std::memory_order_acquire)[id + 1 - segmentSize(segment)];
+    }
+
+    Keyword::Id count() const
+    {
+        return size.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr unsigned segmentCount = 32;
+    static constexpr std::size_t shardCount = 16;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, Keyword::Id> ids;
+    };
+
+    std::array<Shard, shardCount> shards;
+    std::mutex appendMutex;
+    std::array<std::atomic<std::string *>, segmentCount> segments;
+    std::atomic<Keyword::Id> size{0};
+
+    Keyword::Id append(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock{appendMutex};
+        auto id = size.load(std::memory_order_relaxed);
+        if (id == std::numeric_limits<Keyword::Id>::max())
+            throw std::length_error("too many keywords");
+        auto segment = segmentOf(id);
+        auto names = segments[segment].load(std::memory_order_relaxed);
+        if (!names)
+        {
+            names = new std::string[segmentSize(segment)];
+            segments[segment].store(names, std::memory_order_release);
+        }
+        names[id + 1 - segmentSize(segment)] = name;
+        size.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    static unsigned segmentOf(Keyword::Id id)
+    {
+        return floorLog2(std::uint32_t(id) + 1);
+    }
+
+    static unsigned floorLog2(std::uint32_t value)
+    {
+        unsigned log = 0;
+        for (unsigned shift = 16; shift != 0; shift /= 2)
+            if (value >> shift)
+            {
+                value >>= shift;
+                log += shift;
+            }
+        return log;
+    }
+
+    static std::size_t segmentSize(unsigned segment)
+    {
+        return std::size_t(1) << segment;
+    }
+};
+
+SymbolTable& symbols()
+{
+    static SymbolTable table;
+    return table;
+}
+
+}
+
+Keyword::Keyword(const std::string& name) : id(symbols().intern(name)) { }
+
+const std::string& Keyword::str() const
+{
+    return symbols().str(id);
+}
+
+Keyword::Id Keyword::count()
+{
+    return symbols().count();
+}
+
+Keyword Keyword::fromIndex(Id id)
+{
+    if (id >= count())
+        throw std::out_of_range("unknown keyword index");
+    Keyword keyword;
+    keyword.id = id;
+    return keyword;
+}
+
+const Keyword& Keyword::literal(const char *text, std::size_t size)
+{
+    thread_local std::unordered_map<const char *, Keyword> byAddress;
+    thread_local std::unordered_map<std::string, Keyword> byName;
+    auto found = byAddress.find(text);
+    if (found == end(byAddress))
+        found = byAddress.emplace(text, Keyword(std::string(text, size))).first;
+    if (found->second.str().size() == size)
+        return found->second;
+    std::string name(text, size);
+    return byName.emplace(name, Keyword(name)).first->second;
 }
 
 }
@@ -1,6 +1,9 @@
 #pragma once
+#include <cstddef>
 #include <string>
 #include <functional>
+#include <type_traits>
+#include <cstdint>
 
 namespace ecsps
 {
@@ -8,30 +11,61 @@ namespace ecsps
 class Keyword
 {
 public:
-    Keyword() : Keyword(std::string{}) { }
+    using Id = std::uint32_t;
+
+    constexpr Keyword() : id(0) { }
     explicit Keyword(const std::string& name);
 
-    const std::string& str() const { return *name; }
+    const std::string& str() const;
+
+    Id index() const { return id; }
+
+    static Id count();
+    static Keyword fromIndex(Id id);
+    static const Keyword& literal(const char *text, std::size_t size);
 
     std::size_t hash() const
     {
-        return std::hash<decltype(name)>()(name);
+        return id;
     }
 
     friend bool operator==(const Keyword& left, const Keyword& right)
     {
-        return left.name == right.name;
+        return left.id == right.id;
     }
 
 private:
-    std::shared_ptr<const std::string> name;
+    Id id;
 };
 
-inline Keyword operator""_k(const char *text, std::size_t length)
+#if defined(__GNUC__) && !defined(ECSPS_STANDARD_KEYWORD_LITERALS)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wgnu-string-literal-operator-template"
+#endif
+
+template <typename Char, Char... text>
+const Keyword& operator""_k()
 {
-    return Keyword{std::string{text, length}};
+    static_assert(std::is_same<Char, char>::value, "keyword literals must be narrow strings");
+    static const Char chars[] = {text..., Char()};
+    static const Keyword keyword{std::string{chars, sizeof...(text)}};
+    return keyword;
 }
 
+#pragma GCC diagnostic pop
+
+#else
+
+inline const Keyword& operator""_k(const char *text, std::size_t size)
+{
+    return Keyword::literal(text, size);
+}
+
+#endif
+
 inline bool operator!=(const Keyword& left, const Keyword& right)
 {
     return !(left == right);
@@ -0,0 +1,69 @@
+#pragma once
+#include "Keyword.hpp"
+#include "SparsePool.hpp"
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace ecsps
+{
+
+template <typename Value>
+class KeywordMap
+{
+public:
+    using value_type = std::pair<Keyword, Value>;
+
+    KeywordMap() = default;
+
+    template <typename Iterator>
+    KeywordMap(Iterator first, Iterator last)
+    {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    KeywordMap(std::initializer_list<value_type> values) : KeywordMap(values.begin(), values.end()) { }
+
+    bool insert(const value_type& value)
+    {
+        if (contains(value.first))
+            return false;
+        values.insert(value.first.index(), value.second);
+        return true;
+    }
+
+    Value& operator[](Keyword key)
+    {
+        if (!contains(key))
+            return values.insert(key.index(), Value{});
+        return values.get(key.index());
+    }
+
+    Value& at(Keyword key)
+    {
+        if (!contains(key))
+            throw std::out_of_range("unknown keyword: " + key.str());
+        return values.get(key.index());
+    }
+
+    const Value& at(Keyword key) const
+    {
+        if (!contains(key))
+            throw std::out_of_range("unknown keyword: " + key.str());
+        return values.get(key.index());
+    }
+
+    Value *find(Keyword key) { return contains(key) ? &values.get(key.index()) : nullptr; }
+    const Value *find(Keyword key) const { return contains(key) ? &values.get(key.index()) : nullptr; }
+
+    bool contains(Keyword key) const { return values.contains(key.index()); }
+
+    std::size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+
+private:
+    SparsePool<Value, Keyword::Id> values;
+};
+
+}
@@ -0,0 +1,70 @@
+#include "MappedFile.hpp"
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ECSPS_MAPPED_FILE_MMAP 1
+#else
+#include <fstream>
+#define ECSPS_MAPPED_FILE_MMAP 0
+#endif
+
+namespace ecsps
+{
+
+#if ECSPS_MAPPED_FILE_MMAP
+
+MappedFile::MappedFile(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("cannot open " + path);
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("cannot stat " + path);
+    }
+    length = std::size_t(info.st_size);
+    if (length > 0)
+    {
+        void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            ::close(fd);
+            throw std::runtime_error("cannot map " + path);
+        }
+        bytes = static_cast<const char *>(mapping);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (bytes)
+        ::munmap(const_cast<char *>(bytes), length);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path)
+{
+    std::ifstream is(path, std::ios::binary | std::ios::ate);
+    if (!is)
+        throw std::runtime_error("cannot open " + path);
+    length = std::size_t(is.tellg());
+    buffer.resize((length + sizeof(buffer[0]) - 1) / sizeof(buffer[0]));
+    is.seekg(0);
+    if (!is.read(reinterpret_cast<char *>(buffer.data()), std::streamsize(length)))
+        throw std::runtime_error("cannot read " + path);
+    bytes = reinterpret_cast<const char *>(buffer.data());
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ecsps
+{
+
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile& ) = delete;
+    MappedFile& operator=(const MappedFile& ) = delete;
+
+    const char *data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    const char *bytes = nullptr;
+    std::size_t length = 0;
+    std::vector<std::uint64_t> buffer;
+};
+
+}
@@ -0,0 +1,107 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <string>
+
+namespace ecsps
+{
+
+namespace
+{
+
+std::size_t roundUpToPowerOfTwo(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+void writeEscaped(std::ostream& os, const char *text)
+{
+    for (; *text; ++text)
+    {
+        if (*text == '"' || *text == '\\')
+            os << '\\';
+        os << *text;
+    }
+}
+
+}
+
+Profiler::Profiler(std::size_t capacity)
+    : mask(roundUpToPowerOfTwo(std::max<std::size_t>(capacity, 1)) - 1), slots(new Slot[mask + 1]), origin(Clock::now()) { }
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::record(const char *name, Clock::time_point start, Clock::time_point end)
+{
+    auto index = head.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots[index & mask];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(std::chrono::duration_cast<std::chrono::nanoseconds>(start - origin).count(), std::memory_order_relaxed);
+    slot.duration.store(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), std::memory_order_relaxed);
+    slot.thread.store(threadId(), std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::clear()
+{
+    for (std::size_t i = 0; i <= mask; ++i)
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+    head.store(0, std::memory_order_release);
+}
+
+std::vector<ProfileSpan> Profiler::spans() const
+{
+    auto end = head.load(std::memory_order_acquire);
+    auto begin = end > mask + 1 ? end - (mask + 1) : 0;
+    std::vector<ProfileSpan> spans;
+    spans.reserve(end - begin);
+    for (auto index = begin; index < end; ++index)
+    {
+        auto& slot = slots[index & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+            continue;
+        ProfileSpan span{
+            slot.name.load(std::memory_order_relaxed),
+            slot.start.load(std::memory_order_relaxed),
+            slot.duration.load(std::memory_order_relaxed),
+            slot.thread.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == index + 1)
+            spans.push_back(span);
+    }
+    std::stable_sort(spans.begin(), spans.end(), [](const ProfileSpan& left, const ProfileSpan& right) { return left.start < right.start; });
+    return spans;
+}
+
+void Profiler::writeChromeTrace(std::ostream& os) const
+{
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (auto& span : spans())
+    {
+        os << (first ? "\n" : ",\n") << "{\"name\":\"";
+        writeEscaped(os, span.name);
+        os << "\",\"cat\":\"ecsps\",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.thread
+           << ",\"ts\":" << span.start / 1000 << "." << std::to_string(1000 + span.start % 1000).substr(1)
+           << ",\"dur\":" << span.duration / 1000 << "." << std::to_string(1000 + span.duration % 1000).substr(1) << "}";
+        first = false;
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+std::uint32_t Profiler::threadId()
+{
+    static std::atomic<std::uint32_t> nextId{0};
+    thread_local std::uint32_t id = nextId++;
+    return id;
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace ecsps
+{
+
+struct ProfileSpan
+{
+    const char *name;
+    std::uint64_t start;
+    std::uint64_t duration;
+    std::uint32_t thread;
+};
+
+class Profiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Profiler(std::size_t capacity = 1 << 16);
+
+    Profiler(const Profiler& ) = delete;
+    Profiler& operator=(const Profiler& ) = delete;
+
+    static Profiler& instance();
+
+    std::size_t capacity() const { return mask + 1; }
+
+    void record(const char *name, Clock::time_point start, Clock::time_point end);
+    void clear();
+
+    std::vector<ProfileSpan> spans() const;
+    void writeChromeTrace(std::ostream& os) const;
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<const char *> name{nullptr};
+        std::atomic<std::uint64_t> start{0};
+        std::atomic<std::uint64_t> duration{0};
+        std::atomic<std::uint32_t> thread{0};
+    };
+
+    std::size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<std::uint64_t> head{0};
+    Clock::time_point origin;
+
+    static std::uint32_t threadId();
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char *name, Profiler& profiler = Profiler::instance())
+        : name(name), profiler(profiler), start(Profiler::Clock::now()) { }
+
+    ~ProfileScope()
+    {
+        profiler.record(name, start, Profiler::Clock::now());
+    }
+
+    ProfileScope(const ProfileScope& ) = delete;
+    ProfileScope& operator=(const ProfileScope& ) = delete;
+
+private:
+    const char *name;
+    Profiler& profiler;
+    Profiler::Clock::time_point start;
+};
+
+}
+
+#define ECSPS_PROFILE_CONCAT2(a, b) a##b
+#define ECSPS_PROFILE_CONCAT(a, b) ECSPS_PROFILE_CONCAT2(a, b)
+
+#ifdef ECSPS_PROFILING
+#define ECSPS_PROFILE_SCOPE(name) ::ecsps::ProfileScope ECSPS_PROFILE_CONCAT(profileScope, __LINE__){name}
+#else
+#define ECSPS_PROFILE_SCOPE(name) ((void)0)
+#endif
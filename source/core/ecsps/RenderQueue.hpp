@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ecsps
+{
+
+template <typename Payload>
+class RenderQueue
+{
+public:
+    using Key = std::uint32_t;
+
+    struct Item
+    {
+        Key key;
+        Payload payload;
+    };
+
+    static Key key(std::uint16_t bin, std::uint16_t texture)
+    {
+        return (Key(bin) << 16) | texture;
+    }
+
+    static std::uint16_t bin(Key key) { return std::uint16_t(key >> 16); }
+    static std::uint16_t texture(Key key) { return std::uint16_t(key); }
+
+    void push(std::uint16_t bin, std::uint16_t texture, Payload payload)
+    {
+        items.push_back({key(bin, texture), std::move(payload)});
+    }
+
+    void clear() { items.clear(); }
+
+    void sort()
+    {
+        std::array<std::array<std::size_t, 256>, sizeof(Key)> counts{};
+        for (auto& item : items)
+            for (std::size_t digit = 0; digit < sizeof(Key); ++digit)
+                ++counts[digit][(item.key >> (digit * 8)) & 0xff];
+
+        for (std::size_t digit = 0; digit < sizeof(Key); ++digit)
+        {
+            auto& count = counts[digit];
+            if (count[(items.empty() ? 0 : items.front().key >> (digit * 8)) & 0xff] == items.size())
+                continue;
+            std::size_t offset = 0;
+            for (auto& c : count)
+                offset += std::exchange(c, offset);
+            buffer.resize(items.size());
+            for (auto& item : items)
+                buffer[count[(item.key >> (digit * 8)) & 0xff]++] = std::move(item);
+            items.swap(buffer);
+        }
+    }
+
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    auto begin() const { return items.begin(); }
+    auto end() const { return items.end(); }
+
+private:
+    std::vector<Item> items;
+    std::vector<Item> buffer;
+};
+
+}
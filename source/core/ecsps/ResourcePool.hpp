@@ -1,8 +1,14 @@
 #pragma once
+#include "ThreadPool.hpp"
+#include <array>
+#include <cassert>
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <mutex>
 #include <functional>
+#include <future>
+#include <thread>
 
 namespace ecsps
 {
@@ -12,26 +18,126 @@ class ResourcePool : public std::enable_shared_from_this<ResourcePool<Id, Resour
 {
 public:
     using Factory = std::function<std::unique_ptr<const Resource>(const Id& )>;
+    using Future = std::shared_future<std::shared_ptr<const Resource>>;
 
-    ResourcePool(Factory createResource) : createResource(std::move(createResource)) { }
+    static constexpr std::size_t shardCount = 16;
+
+    ResourcePool(Factory createResource, std::shared_ptr<ThreadPool> loaders = nullptr)
+        : createResource(std::move(createResource)), hasLoaders(loaders != nullptr), loaders(std::move(loaders)) { }
 
     std::shared_ptr<const Resource> get(const Id& id)
     {
-        std::lock_guard<std::mutex> lock{mutex};
+        if (auto resource = find(id))
+            return resource;
+        return wait(request(id, false));
+    }
 
-        auto found = pool.find(id);
-        if (found != end(pool))
-            return found->second.lock();
+    Future getAsync(const Id& id)
+    {
+        return request(id, true);
+    }
 
-        auto ptr = create(id);
-        pool.insert({id, ptr});
-        return ptr;
+    std::shared_ptr<const Resource> wait(const Future& future)
+    {
+        if (auto threadPool = loaderPool())
+            while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                if (!threadPool->runPendingTask())
+                    std::this_thread::yield();
+        return future.get();
     }
 
 private:
+    using Promise = std::promise<std::shared_ptr<const Resource>>;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<Id, std::weak_ptr<const Resource>> pool;
+        std::unordered_map<Id, Future> loading;
+    };
+
     Factory createResource;
-    std::mutex mutex;
-    std::unordered_map<Id, std::weak_ptr<const Resource>> pool;
+    bool hasLoaders;
+    // Weak, so that a load task dropping the last reference to this pool never destroys the thread pool it runs on.
+    // The loader pool must outlive the resource pool.
+    std::weak_ptr<ThreadPool> loaders;
+    std::array<Shard, shardCount> shards;
+
+    std::shared_ptr<ThreadPool> loaderPool() const
+    {
+        auto threadPool = loaders.lock();
+        assert((threadPool || !hasLoaders) && "ecsps::ResourcePool: loader thread pool destroyed before the resource pool");
+        return threadPool;
+    }
+
+    Shard& shardFor(const Id& id)
+    {
+        return shards[std::hash<Id>()(id) % shardCount];
+    }
+
+    std::shared_ptr<const Resource> find(const Id& id)
+    {
+        auto& shard = shardFor(id);
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        auto found = shard.pool.find(id);
+        return found != end(shard.pool) ? found->second.lock() : nullptr;
+    }
+
+    Future request(const Id& id, bool async)
+    {
+        auto& shard = shardFor(id);
+        std::unique_lock<std::mutex> lock{shard.mutex};
+
+        auto found = shard.pool.find(id);
+        if (found != end(shard.pool))
+            if (auto resource = found->second.lock())
+            {
+                Promise ready;
+                ready.set_value(std::move(resource));
+                return ready.get_future().share();
+            }
+
+        auto inFlight = shard.loading.find(id);
+        if (inFlight != end(shard.loading))
+            return inFlight->second;
+
+        auto promise = std::make_shared<Promise>();
+        auto future = promise->get_future().share();
+        shard.loading.insert({id, future});
+        lock.unlock();
+
+        auto self = this->shared_from_this();
+        auto load = [self, id, promise] { self->load(id, *promise); };
+        auto threadPool = async ? loaderPool() : nullptr;
+        if (threadPool)
+            threadPool->submit(std::move(load));
+        else
+            load();
+        return future;
+    }
+
+    void load(const Id& id, Promise& promise)
+    {
+        auto& shard = shardFor(id);
+        try
+        {
+            auto ptr = create(id);
+            {
+                std::lock_guard<std::mutex> lock{shard.mutex};
+                shard.pool[id] = ptr;
+                shard.loading.erase(id);
+            }
+            promise.set_value(std::move(ptr));
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock{shard.mutex};
+                shard.loading.erase(id);
+            }
+            promise.set_exception(std::current_exception());
+        }
+    }
 
     std::shared_ptr<const Resource> create(const Id& id)
     {
@@ -49,8 +155,11 @@ private:
 
     void forget(const Id& value)
     {
-        std::lock_guard<std::mutex> lock{mutex};
-        pool.erase(value);
+        auto& shard = shardFor(value);
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        auto found = shard.pool.find(value);
+        if (found != end(shard.pool) && found->second.expired())
+            shard.pool.erase(found);
     }
 };
 
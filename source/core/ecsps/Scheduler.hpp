@@ -0,0 +1,146 @@
+#pragma once
+#include "ComponentSignature.hpp"
+#include "ThreadPool.hpp"
+#include "WriteScope.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+namespace ecsps
+{
+
+template <typename... Components>
+struct Reads { };
+
+template <typename... Components>
+struct Writes { };
+
+enum class Affinity
+{
+    anyThread,
+    mainThread
+};
+
+template <typename... AllComponents>
+class Scheduler
+{
+public:
+    using System = std::function<void()>;
+
+    explicit Scheduler(std::shared_ptr<ThreadPool> threadPool) : threadPool(std::move(threadPool)) { }
+
+    template <typename... ReadComponents, typename... WriteComponents>
+    std::size_t add(Reads<ReadComponents...>, Writes<WriteComponents...>, System system, Affinity affinity = Affinity::anyThread)
+    {
+        Node node{Signature::template of<ReadComponents...>(), Signature::template of<WriteComponents...>(), std::move(system), affinity};
+        node.writeTypes = {typeid(WriteComponents)...};
+        auto index = nodes.size();
+        for (std::size_t i = 0; i < index; ++i)
+            if (conflicts(nodes[i], node))
+            {
+                nodes[i].dependents.push_back(index);
+                ++node.dependencyCount;
+            }
+        nodes.push_back(std::move(node));
+        return index;
+    }
+
+    const std::vector<std::size_t>& dependents(std::size_t system) const { return nodes[system].dependents; }
+
+    void run()
+    {
+        Run run{nodes.size()};
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+            run.pending[i] = nodes[i].dependencyCount;
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+            if (nodes[i].dependencyCount == 0)
+                dispatch(run, i);
+
+        while (run.unfinished.load() != 0)
+        {
+            std::size_t system;
+            if (run.popMainThreadSystem(system))
+                execute(run, system);
+            else if (!threadPool->runPendingTask())
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    using Signature = ComponentSignature<AllComponents...>;
+
+    struct Node
+    {
+        typename Signature::type reads;
+        typename Signature::type writes;
+        std::vector<std::type_index> writeTypes;
+        System system;
+        Affinity affinity;
+        std::vector<std::size_t> dependents;
+        unsigned dependencyCount = 0;
+
+        Node(typename Signature::type reads, typename Signature::type writes, System system, Affinity affinity)
+            : reads(reads), writes(writes), system(std::move(system)), affinity(affinity) { }
+    };
+
+    struct Run
+    {
+        std::unique_ptr<std::atomic<unsigned>[]> pending;
+        std::atomic<std::size_t> unfinished;
+        std::mutex mainThreadMutex;
+        std::vector<std::size_t> mainThreadSystems;
+
+        explicit Run(std::size_t size) : pending(new std::atomic<unsigned>[size]), unfinished(size) { }
+
+        bool popMainThreadSystem(std::size_t& system)
+        {
+            std::lock_guard<std::mutex> lock{mainThreadMutex};
+            if (mainThreadSystems.empty())
+                return false;
+            system = mainThreadSystems.front();
+            mainThreadSystems.erase(begin(mainThreadSystems));
+            return true;
+        }
+    };
+
+    std::shared_ptr<ThreadPool> threadPool;
+    std::vector<Node> nodes;
+
+    static bool conflicts(const Node& earlier, const Node& later)
+    {
+        return (later.writes & (earlier.reads | earlier.writes)).any() || (later.reads & earlier.writes).any();
+    }
+
+    void dispatch(Run& run, std::size_t system)
+    {
+        if (nodes[system].affinity == Affinity::mainThread)
+        {
+            std::lock_guard<std::mutex> lock{run.mainThreadMutex};
+            run.mainThreadSystems.push_back(system);
+        }
+        else
+        {
+            threadPool->submit([this, &run, system] { execute(run, system); });
+        }
+    }
+
+    void execute(Run& run, std::size_t system)
+    {
+        {
+#ifndef NDEBUG
+            WriteScope scope{nodes[system].writeTypes};
+#endif
+            nodes[system].system();
+        }
+        for (auto dependent : nodes[system].dependents)
+            if (--run.pending[dependent] == 0)
+                dispatch(run, dependent);
+        --run.unfinished;
+    }
+};
+
+}
@@ -0,0 +1,325 @@
+#pragma once
+#include "EntitySystem.hpp"
+#include "Keyword.hpp"
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ecsps
+{
+
+template <typename Component>
+struct IsSnapshotBitwise : std::is_trivially_copyable<Component> { };
+
+class KeywordRemap
+{
+public:
+    explicit KeywordRemap(std::vector<Keyword> keywords) : keywords(std::move(keywords)) { }
+
+    Keyword operator()(Keyword saved) const
+    {
+        if (saved.index() >= keywords.size())
+            throw std::runtime_error("ecsps::Snapshot: keyword outside of the string table");
+        return keywords[saved.index()];
+    }
+
+private:
+    std::vector<Keyword> keywords;
+};
+
+template <typename Component>
+struct IsKeywordFree : std::false_type { };
+
+template <typename Component, typename = void>
+struct HasKeywordRemap : std::false_type { };
+
+template <typename Component>
+struct HasKeywordRemap<Component, decltype(remapKeywords(std::declval<Component&>(), std::declval<const KeywordRemap&>()))> : std::true_type { };
+
+struct SnapshotAccess
+{
+    template <typename... AllComponents>
+    static void save(const EntitySystem<AllComponents...>& es, std::ostream& os)
+    {
+        checkLayout<AllComponents...>();
+        Writer writer{os};
+        writer.write(magic(), magicSize);
+        writer.value(std::uint32_t(version));
+        writer.value(std::uint32_t(sizeof...(AllComponents)));
+        writer.value(std::uint64_t(es.slots.size()));
+        writer.value(std::uint64_t(es.freeIndices.size()));
+
+        std::vector<std::uint32_t> componentSizes{std::uint32_t(sizeof(AllComponents))...};
+        writer.array(componentSizes.data(), componentSizes.size());
+
+        auto keywordCount = Keyword::count();
+        std::vector<std::uint64_t> offsets{0};
+        std::string names;
+        for (Keyword::Id id = 0; id < keywordCount; ++id)
+        {
+            names += Keyword::fromIndex(id).str();
+            offsets.push_back(names.size());
+        }
+        writer.value(std::uint64_t(keywordCount));
+        writer.array(offsets.data(), offsets.size());
+        writer.array(names.data(), names.size());
+
+        std::vector<std::uint64_t> signatures;
+        std::vector<Entity::Generation> generations;
+        for (auto& slot : es.slots)
+        {
+            signatures.push_back(slot.signature.to_ullong());
+            generations.push_back(slot.generation);
+        }
+        writer.array(signatures.data(), signatures.size());
+        writer.array(generations.data(), generations.size());
+        writer.array(es.freeIndices.data(), es.freeIndices.size());
+
+        int pools[] = {0, (savePool(writer, es.template pool<AllComponents>()), 0)...};
+        (void)pools;
+    }
+
+    template <typename... AllComponents>
+    static void load(EntitySystem<AllComponents...>& es, const char *data, std::size_t size)
+    {
+        checkLayout<AllComponents...>();
+        Reader reader{data, size};
+        if (std::memcmp(reader.array<char>(magicSize), magic(), magicSize) != 0)
+            throw std::runtime_error("ecsps::Snapshot: not a snapshot");
+        if (reader.value<std::uint32_t>() != version)
+            throw std::runtime_error("ecsps::Snapshot: unsupported version");
+        auto componentCount = reader.value<std::uint32_t>();
+        auto slotCount = reader.value<std::uint64_t>();
+        auto freeCount = reader.value<std::uint64_t>();
+
+        std::vector<std::uint32_t> expectedSizes{std::uint32_t(sizeof(AllComponents))...};
+        if (componentCount != sizeof...(AllComponents) ||
+            std::memcmp(reader.array<std::uint32_t>(componentCount), expectedSizes.data(), componentCount * sizeof(std::uint32_t)) != 0)
+            throw std::runtime_error("ecsps::Snapshot: component layout mismatch");
+
+        auto keywordCount = reader.value<std::uint64_t>();
+        if (keywordCount >= reader.remaining() / sizeof(std::uint64_t))
+            throw std::runtime_error("ecsps::Snapshot: corrupt string table");
+        auto offsets = reader.array<std::uint64_t>(keywordCount + 1);
+        auto names = reader.array<char>(offsets[keywordCount]);
+        std::vector<Keyword> keywords;
+        for (std::uint64_t id = 0; id < keywordCount; ++id)
+        {
+            if (offsets[id] > offsets[id + 1])
+                throw std::runtime_error("ecsps::Snapshot: corrupt string table");
+            keywords.emplace_back(std::string(names + offsets[id], names + offsets[id + 1]));
+        }
+
+        using Entities = EntitySystem<AllComponents...>;
+        using Signature = typename Entities::Signature;
+        auto signatures = reader.array<std::uint64_t>(slotCount);
+        auto generations = reader.array<Entity::Generation>(slotCount);
+        std::vector<typename Entities::Slot> slots(slotCount);
+        for (std::uint64_t i = 0; i < slotCount; ++i)
+        {
+            if (sizeof...(AllComponents) < 64 && (signatures[i] >> sizeof...(AllComponents)) != 0)
+                throw std::runtime_error("ecsps::Snapshot: corrupt entity table");
+            slots[i] = {typename Signature::type(signatures[i]), generations[i]};
+        }
+
+        auto freeData = reader.array<Entity::Index>(freeCount);
+        std::vector<Entity::Index> freeIndices(freeData, freeData + freeCount);
+        std::vector<bool> free(slotCount);
+        for (auto index : freeIndices)
+        {
+            if (index >= slotCount || free[index] || slots[index].signature.any())
+                throw std::runtime_error("ecsps::Snapshot: corrupt entity table");
+            free[index] = true;
+        }
+
+        std::tuple<SparsePool<AllComponents, Entity::Index>...> pools;
+        int staged[] = {0, (readPool(reader, std::get<SparsePool<AllComponents, Entity::Index>>(pools), slots, Signature::template index<AllComponents>()), 0)...};
+        (void)staged;
+
+        KeywordRemap remap{std::move(keywords)};
+        int remapped[] = {0, (remapPool(std::get<SparsePool<AllComponents, Entity::Index>>(pools), remap), 0)...};
+        (void)remapped;
+
+        std::lock_guard<std::mutex> lock{es.groupsMutex};
+        std::vector<std::unique_ptr<typename Entities::Group>> groups;
+        for (auto& group : es.groups)
+        {
+            groups.push_back(std::make_unique<typename Entities::Group>(group->mask));
+            for (Entity::Index index = 0; index < slotCount; ++index)
+                if (Signature::contains(slots[index].signature, group->mask))
+                    groups.back()->insert(index);
+        }
+
+        es.pools.swap(pools);
+        es.slots.swap(slots);
+        es.freeIndices.swap(freeIndices);
+        for (std::size_t i = 0; i < groups.size(); ++i)
+        {
+            es.groups[i]->entities.swap(groups[i]->entities);
+            es.groups[i]->positions.swap(groups[i]->positions);
+            ++es.groups[i]->membership;
+        }
+        ++es.epoch;
+    }
+
+private:
+    static constexpr std::size_t magicSize = 8;
+    static constexpr std::uint32_t version = 1;
+
+    static const char *magic() { return "ECSPSNAP"; }
+
+    class Writer
+    {
+    public:
+        explicit Writer(std::ostream& os) : os(os) { }
+
+        void write(const void *data, std::size_t size)
+        {
+            os.write(static_cast<const char *>(data), std::streamsize(size));
+            offset += size;
+        }
+
+        template <typename T>
+        void value(const T& value)
+        {
+            write(&value, sizeof(value));
+        }
+
+        template <typename T>
+        void array(const T *data, std::size_t count)
+        {
+            write(data, count * sizeof(T));
+            static const char zeros[8] = {};
+            write(zeros, (8 - offset % 8) % 8);
+        }
+
+    private:
+        std::ostream& os;
+        std::size_t offset = 0;
+    };
+
+    class Reader
+    {
+    public:
+        Reader(const char *data, std::size_t size) : data(data), size(size) { }
+
+        template <typename T>
+        T value()
+        {
+            T value;
+            std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        const T *array(std::size_t count)
+        {
+            if (count > size / sizeof(T))
+                throw std::runtime_error("ecsps::Snapshot: truncated file");
+            auto values = reinterpret_cast<const T *>(take(count * sizeof(T)));
+            take((8 - offset % 8) % 8);
+            return values;
+        }
+
+        std::size_t remaining() const { return size - offset; }
+
+    private:
+        const char *data;
+        std::size_t size;
+        std::size_t offset = 0;
+
+        const char *take(std::size_t bytes)
+        {
+            if (bytes > size - offset)
+                throw std::runtime_error("ecsps::Snapshot: truncated file");
+            auto begin = data + offset;
+            offset += bytes;
+            return begin;
+        }
+    };
+
+    template <typename... AllComponents>
+    static void checkLayout()
+    {
+        static_assert(sizeof...(AllComponents) <= 64, "snapshots support up to 64 component types");
+        static_assert(allOf(IsSnapshotBitwise<AllComponents>::value && alignof(AllComponents) <= 8 ...), "snapshot components must be bitwise copyable and at most 8-byte aligned");
+        static_assert(allOf(IsKeywordFree<AllComponents>::value || HasKeywordRemap<AllComponents>::value ...), "snapshot components must be declared IsKeywordFree or have a remapKeywords overload");
+    }
+
+    static constexpr bool allOf() { return true; }
+
+    template <typename... Bools>
+    static constexpr bool allOf(bool first, Bools... rest) { return first && allOf(rest...); }
+
+    template <typename Component>
+    static void savePool(Writer& writer, const SparsePool<Component, Entity::Index>& pool)
+    {
+        writer.value(std::uint64_t(pool.size()));
+        writer.array(reinterpret_cast<const char *>(pool.data()), pool.size() * sizeof(Component));
+        writer.array(pool.entityIndices().data(), pool.size());
+    }
+
+    template <typename Component, typename Slot>
+    static void readPool(Reader& reader, SparsePool<Component, Entity::Index>& pool, const std::vector<Slot>& slots, std::size_t component)
+    {
+        auto count = reader.value<std::uint64_t>();
+        auto components = reader.array<Component>(count);
+        auto entities = reader.array<Entity::Index>(count);
+        for (std::uint64_t i = 0; i < count; ++i)
+            if (entities[i] >= slots.size())
+                throw std::runtime_error("ecsps::Snapshot: corrupt component pool");
+        pool.assign(components, entities, std::size_t(count), slots.size());
+        for (std::uint64_t i = 0; i < count; ++i)
+            if (&pool.get(entities[i]) != pool.data() + i)
+                throw std::runtime_error("ecsps::Snapshot: duplicate entity in component pool");
+
+        for (Entity::Index index = 0; index < slots.size(); ++index)
+            if (slots[index].signature.test(component) != pool.contains(index))
+                throw std::runtime_error("ecsps::Snapshot: entity signature does not match component pools");
+    }
+
+    template <typename Component>
+    static void remapPool(SparsePool<Component, Entity::Index>& pool, const KeywordRemap& remap)
+    {
+        remapPool(pool, remap, HasKeywordRemap<Component>{});
+    }
+
+    template <typename Component>
+    static void remapPool(SparsePool<Component, Entity::Index>& , const KeywordRemap& , std::false_type) { }
+
+    template <typename Component>
+    static void remapPool(SparsePool<Component, Entity::Index>& pool, const KeywordRemap& remap, std::true_type)
+    {
+        for (auto& component : pool)
+            remapKeywords(component, remap);
+    }
+};
+
+template <typename... AllComponents>
+void saveSnapshot(const EntitySystem<AllComponents...>& es, const std::string& path)
+{
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os)
+        throw std::runtime_error("cannot write " + path);
+    SnapshotAccess::save(es, os);
+    if (!os.flush())
+        throw std::runtime_error("cannot write " + path);
+}
+
+template <typename... AllComponents>
+void loadSnapshot(EntitySystem<AllComponents...>& es, const std::string& path)
+{
+    MappedFile file{path};
+    SnapshotAccess::load(es, file.data(), file.size());
+}
+
+}
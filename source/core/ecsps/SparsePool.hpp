@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ecsps
+{
+
+template <typename Component, typename Index = std::uint32_t>
+class SparsePool
+{
+public:
+    static constexpr Index npos = std::numeric_limits<Index>::max();
+
+    template <typename C>
+    Component& insert(Index entity, C&& component)
+    {
+        if (entity >= sparse.size())
+            sparse.resize(entity + 1, npos);
+        if (sparse[entity] != npos)
+            return dense[sparse[entity]] = std::forward<C>(component);
+        sparse[entity] = Index(dense.size());
+        dense.push_back(std::forward<C>(component));
+        entities.push_back(entity);
+        return dense.back();
+    }
+
+    void erase(Index entity)
+    {
+        if (!contains(entity))
+            return;
+        auto index = sparse[entity];
+        auto last = entities.back();
+        if (index != dense.size() - 1)
+        {
+            dense[index] = std::move(dense.back());
+            entities[index] = last;
+            sparse[last] = index;
+        }
+        dense.pop_back();
+        entities.pop_back();
+        sparse[entity] = npos;
+    }
+
+    void assign(const Component *components, const Index *entityIndices, std::size_t count, std::size_t sparseSize)
+    {
+        dense.assign(components, components + count);
+        entities.assign(entityIndices, entityIndices + count);
+        sparse.assign(sparseSize, npos);
+        for (std::size_t i = 0; i < count; ++i)
+            sparse[entities[i]] = Index(i);
+    }
+
+    bool contains(Index entity) const
+    {
+        return entity < sparse.size() && sparse[entity] != npos;
+    }
+
+    Component& get(Index entity) { return dense[sparse[entity]]; }
+    const Component& get(Index entity) const { return dense[sparse[entity]]; }
+
+    std::size_t size() const { return dense.size(); }
+    bool empty() const { return dense.empty(); }
+
+    Component *data() { return dense.data(); }
+    const Component *data() const { return dense.data(); }
+
+    const std::vector<Index>& entityIndices() const { return entities; }
+
+    auto begin() { return dense.begin(); }
+    auto end() { return dense.end(); }
+    auto begin() const { return dense.begin(); }
+    auto end() const { return dense.end(); }
+
+private:
+    std::vector<Component> dense;
+    std::vector<Index> entities;
+    std::vector<Index> sparse;
+};
+
+template <typename Component, typename Index>
+constexpr Index SparsePool<Component, Index>::npos;
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "Math.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ecsps
+{
+
+template <typename Value>
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(float cellSize) : cellSize(cellSize) { }
+
+    void insert(const vec2f& position, const vec2f& size, Value value)
+    {
+        auto id = std::uint32_t(items.size());
+        items.push_back({position, size, std::move(value)});
+        forEachCell(position, size, [&](std::int64_t cell) { cells[cell].push_back(id); });
+    }
+
+    void clear()
+    {
+        items.clear();
+        cells.clear();
+    }
+
+    std::size_t size() const { return items.size(); }
+
+    template <typename F>
+    void query(const vec2f& position, const vec2f& size, F f)
+    {
+        candidates.clear();
+        forEachCell(position, size, [&](std::int64_t cell)
+        {
+            auto found = cells.find(cell);
+            if (found != end(cells))
+                candidates.insert(end(candidates), begin(found->second), end(found->second));
+        });
+        std::sort(begin(candidates), end(candidates));
+        candidates.erase(std::unique(begin(candidates), end(candidates)), end(candidates));
+        for (auto id : candidates)
+        {
+            auto& item = items[id];
+            if (overlaps(position, size, item.position, item.size))
+                f(item.value);
+        }
+    }
+
+private:
+    struct Item
+    {
+        vec2f position;
+        vec2f size;
+        Value value;
+    };
+
+    float cellSize;
+    std::vector<Item> items;
+    std::unordered_map<std::int64_t, std::vector<std::uint32_t>> cells;
+    std::vector<std::uint32_t> candidates;
+
+    static bool overlaps(const vec2f& pos1, const vec2f& size1, const vec2f& pos2, const vec2f& size2)
+    {
+        return
+            pos1[0] + size1[0] >= pos2[0] && pos1[0] <= pos2[0] + size2[0] &&
+            pos1[1] + size1[1] >= pos2[1] && pos1[1] <= pos2[1] + size2[1];
+    }
+
+    std::int32_t cellCoordinate(float x) const
+    {
+        return std::int32_t(std::floor(x / cellSize));
+    }
+
+    template <typename F>
+    void forEachCell(const vec2f& position, const vec2f& size, F f) const
+    {
+        auto x0 = cellCoordinate(position[0]), x1 = cellCoordinate(position[0] + size[0]);
+        auto y0 = cellCoordinate(position[1]), y1 = cellCoordinate(position[1] + size[1]);
+        for (auto y = y0; y <= y1; ++y)
+            for (auto x = x0; x <= x1; ++x)
+                f(std::int64_t((std::uint64_t(std::uint32_t(y)) << 32) | std::uint32_t(x)));
+    }
+};
+
+}
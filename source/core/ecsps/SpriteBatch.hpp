@@ -0,0 +1,63 @@
+#pragma once
+#include "Math.hpp"
+#include <utility>
+#include <vector>
+
+namespace ecsps
+{
+
+struct SpriteVertex
+{
+    vec2f position;
+    vec2f texCoords;
+};
+
+template <typename Texture>
+class SpriteBatch
+{
+public:
+    void add(const Texture& texture, const vec2f& position, const vec2f& size, const vec2f& texturePosition, bool mirrored)
+    {
+        auto& vertices = batchFor(texture);
+        auto u0 = texturePosition[0], u1 = texturePosition[0] + size[0];
+        auto v0 = texturePosition[1], v1 = texturePosition[1] + size[1];
+        if (mirrored)
+            std::swap(u0, u1);
+        auto x0 = position[0], x1 = position[0] + size[0];
+        auto y0 = position[1], y1 = position[1] + size[1];
+        vertices.push_back({{x0, y0}, {u0, v0}});
+        vertices.push_back({{x1, y0}, {u1, v0}});
+        vertices.push_back({{x1, y1}, {u1, v1}});
+        vertices.push_back({{x0, y1}, {u0, v1}});
+        ++spriteCount;
+    }
+
+    std::size_t size() const { return spriteCount; }
+
+    template <typename Backend>
+    void flush(Backend& backend)
+    {
+        for (auto& batch : batches)
+            if (!batch.second.empty())
+            {
+                backend.draw(*batch.first, batch.second.data(), batch.second.size());
+                batch.second.clear();
+            }
+        spriteCount = 0;
+    }
+
+private:
+    std::vector<std::pair<const Texture *, std::vector<SpriteVertex>>> batches;
+    std::size_t spriteCount = 0;
+
+    std::vector<SpriteVertex>& batchFor(const Texture& texture)
+    {
+        for (auto& batch : batches)
+            if (batch.first == &texture)
+                return batch.second;
+        batches.emplace_back(&texture, std::vector<SpriteVertex>{});
+        return batches.back().second;
+    }
+};
+
+}
@@ -0,0 +1,109 @@
+#include "ThreadPool.hpp"
+
+namespace ecsps
+{
+
+namespace
+{
+
+thread_local ThreadPool *currentPool = nullptr;
+thread_local unsigned currentWorker = 0;
+
+}
+
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    for (unsigned i = 0; i < threadCount; ++i)
+        queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 0; i < threadCount; ++i)
+        threads.emplace_back([this, i] { work(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{sleepMutex};
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void ThreadPool::submit(Task task)
+{
+    if (queues.empty())
+    {
+        task();
+        return;
+    }
+
+    auto index = currentPool == this ? currentWorker : nextQueue++ % size();
+    {
+        std::lock_guard<std::mutex> lock{queues[index]->mutex};
+        queues[index]->tasks.push_back(std::move(task));
+        ++pending;
+    }
+    {
+        std::lock_guard<std::mutex> lock{sleepMutex};
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+    if (queues.empty())
+        return false;
+    return tryRun(currentPool == this ? currentWorker : nextQueue % size());
+}
+
+void ThreadPool::work(unsigned index)
+{
+    currentPool = this;
+    currentWorker = index;
+    while (true)
+    {
+        if (tryRun(index))
+            continue;
+        std::unique_lock<std::mutex> lock{sleepMutex};
+        wake.wait(lock, [this] { return stopping || pending != 0; });
+        if (stopping && pending == 0)
+            return;
+    }
+}
+
+bool ThreadPool::tryRun(unsigned index)
+{
+    Task task;
+    if (!pop(*queues[index], task, true))
+    {
+        bool stolen = false;
+        for (unsigned i = 1; i < size() && !stolen; ++i)
+            stolen = pop(*queues[(index + i) % size()], task, false);
+        if (!stolen)
+            return false;
+    }
+    task();
+    return true;
+}
+
+bool ThreadPool::pop(Queue& queue, Task& task, bool back)
+{
+    std::lock_guard<std::mutex> lock{queue.mutex};
+    if (queue.tasks.empty())
+        return false;
+    if (back)
+    {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+    }
+    else
+    {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+    }
+    --pending;
+    return true;
+}
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ecsps
+{
+
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool& ) = delete;
+    ThreadPool& operator=(const ThreadPool& ) = delete;
+
+    unsigned size() const { return unsigned(queues.size()); }
+
+    void submit(Task task);
+
+    template <typename F>
+    void parallelFor(std::size_t count, std::size_t grainSize, F f)
+    {
+        if (grainSize == 0)
+            grainSize = 1;
+        if (queues.empty() || count <= grainSize)
+        {
+            if (count)
+                f(std::size_t(0), count);
+            return;
+        }
+
+        std::atomic<std::size_t> remaining{(count + grainSize - 1) / grainSize};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        auto run = [&](std::size_t first, std::size_t last)
+        {
+            try
+            {
+                f(first, last);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{errorMutex};
+                if (!error)
+                    error = std::current_exception();
+            }
+            --remaining;
+        };
+        for (std::size_t first = grainSize; first < count; first += grainSize)
+        {
+            auto last = std::min(first + grainSize, count);
+            submit([&run, first, last] { run(first, last); });
+        }
+        run(std::size_t(0), grainSize);
+
+        while (remaining.load() != 0)
+            if (!runPendingTask())
+                std::this_thread::yield();
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    bool runPendingTask();
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<unsigned> nextQueue{0};
+    std::atomic<std::size_t> pending{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    void work(unsigned index);
+    bool tryRun(unsigned index);
+    bool pop(Queue& queue, Task& task, bool back);
+};
+
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <memory>
 #include <unordered_map>
 #include <mutex>
@@ -10,22 +11,36 @@ template <typename Value>
 class ValuePool : public std::enable_shared_from_this<ValuePool<Value>>
 {
 public:
+    static constexpr std::size_t shardCount = 16;
+
     std::shared_ptr<const Value> get(const Value& value)
     {
-        std::lock_guard<std::mutex> lock{mutex};
+        auto& shard = shardFor(value);
+        std::lock_guard<std::mutex> lock{shard.mutex};
 
-        auto found = pool.find(value);
-        if (found != end(pool))
-            return found->second.lock();
+        auto found = shard.pool.find(value);
+        if (found != end(shard.pool))
+            if (auto ptr = found->second.lock())
+                return ptr;
 
         auto ptr = create(value);
-        pool.insert({value, ptr});
+        shard.pool[value] = ptr;
         return ptr;
     }
 
 private:
-    std::mutex mutex;
-    std::unordered_map<Value, std::weak_ptr<const Value>> pool;
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<Value, std::weak_ptr<const Value>> pool;
+    };
+
+    std::array<Shard, shardCount> shards;
+
+    Shard& shardFor(const Value& value)
+    {
+        return shards[std::hash<Value>()(value) % shardCount];
+    }
 
     std::shared_ptr<const Value> create(const Value& value)
     {
@@ -42,8 +57,11 @@ private:
 
     void forget(const Value& value)
     {
-        std::lock_guard<std::mutex> lock{mutex};
-        pool.erase(value);
+        auto& shard = shardFor(value);
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        auto found = shard.pool.find(value);
+        if (found != end(shard.pool) && found->second.expired())
+            shard.pool.erase(found);
     }
 };
 
@@ -0,0 +1,41 @@
+#pragma once
+#include <algorithm>
+#include <typeindex>
+#include <vector>
+
+namespace ecsps
+{
+
+class WriteScope
+{
+public:
+    explicit WriteScope(const std::vector<std::type_index>& writes) : previous(current())
+    {
+        current() = &writes;
+    }
+
+    ~WriteScope()
+    {
+        current() = previous;
+    }
+
+    WriteScope(const WriteScope& ) = delete;
+    WriteScope& operator=(const WriteScope& ) = delete;
+
+    static bool allows(std::type_index component)
+    {
+        auto writes = current();
+        return !writes || std::find(begin(*writes), end(*writes), component) != end(*writes);
+    }
+
+private:
+    const std::vector<std::type_index> *previous;
+
+    static const std::vector<std::type_index> *& current()
+    {
+        static thread_local const std::vector<std::type_index> *writes = nullptr;
+        return writes;
+    }
+};
+
+}
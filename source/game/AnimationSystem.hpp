@@ -0,0 +1,62 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+#include <ecsps/Keyword.hpp>
+#include <ecsps/KeywordMap.hpp>
+#include <ecsps/Profiler.hpp>
+#include "SpriteComponent.hpp"
+
+namespace ecsps
+{
+
+struct Animation
+{
+    std::vector<Keyword> frames;
+    bool loop = true;
+    float framesPerSecond = 15;
+};
+
+struct AnimationComponent
+{
+    Keyword animation;
+    float time = 0;
+};
+
+class AnimationSystem
+{
+public:
+
+    AnimationSystem(std::vector<std::pair<Keyword, Animation>> animations) : animations{begin(animations), end(animations)} { }
+
+    template <typename EntitySystem>
+    void step(EntitySystem& entitySystem, float delta)
+    {
+        ECSPS_PROFILE_SCOPE("AnimationSystem::step");
+        entitySystem.template modify<SpriteComponent, AnimationComponent>()([&](auto& sprite, auto& animationComponent)
+        {
+            auto& animation = animations.at(animationComponent.animation);
+            if (!animation.loop)
+                animationComponent.time = std::min(animationComponent.time + delta, (animation.frames.size() - 1) / animation.framesPerSecond);
+            else
+                animationComponent.time = std::fmod(animationComponent.time + delta, animation.frames.size() / animation.framesPerSecond);
+            sprite.name = animation.frames.at(animationComponent.time * animation.framesPerSecond);
+        });
+    }
+
+private:
+    KeywordMap<Animation> animations;
+};
+
+inline std::vector<Keyword> frameNames(const std::string& prefix, unsigned n)
+{
+    std::vector<Keyword> names;
+    names.reserve(n);
+    for (unsigned i = 1; i <= n; ++i)
+        names.push_back(Keyword{prefix + std::to_string(i)});
+    return names;
+}
+
+}
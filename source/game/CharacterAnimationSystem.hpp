@@ -0,0 +1,60 @@
+#pragma once
+#include <ecsps/Keyword.hpp>
+#include <ecsps/Profiler.hpp>
+#include "AnimationSystem.hpp"
+#include "InputSystem.hpp"
+#include "VelocityComponent.hpp"
+
+namespace ecsps
+{
+
+struct CharacterAnimation
+{
+    Keyword idle_left, idle_right;
+    Keyword run_left, run_right;
+    Keyword jump_left, jump_right;
+    Keyword shoot_left, shoot_right;
+};
+
+class CharacterAnimationSystem
+{
+public:
+    template <typename EntitySystem>
+    void apply(EntitySystem& entitySystem)
+    {
+        ECSPS_PROFILE_SCOPE("CharacterAnimationSystem::apply");
+        entitySystem.template modify<const CharacterAnimation, const CharacterState, const VelocityComponent, AnimationComponent>()([&](const auto& character, const auto& state, const auto& , auto& animation)
+        {
+            if (state.state == "shooting"_k)
+            {
+                if (animation.animation == character.shoot_left || animation.animation == character.shoot_right)
+                    return;
+                animation.animation = state.direction == "left"_k ? character.shoot_left : character.shoot_right;
+                animation.time = 0;
+            }
+            else if (state.state == "jumping"_k)
+            {
+                if (animation.animation == character.jump_left || animation.animation == character.jump_right)
+                    return;
+                animation.animation = state.direction == "left"_k ? character.jump_left : character.jump_right;
+                animation.time = 0;
+            }
+            else if (state.state == "running"_k)
+            {
+                if (animation.animation == character.run_left || animation.animation == character.run_right)
+                    return;
+                animation.animation = state.direction == "left"_k ? character.run_left : character.run_right;
+                animation.time = 0;
+            }
+            else
+            {
+                if (animation.animation == character.idle_left || animation.animation == character.idle_right)
+                    return;
+                animation.animation = state.direction == "left"_k ? character.idle_left : character.idle_right;
+                animation.time = 0;
+            }
+        });
+    }
+};
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <ecsps/InputRecording.hpp>
+#include <ecsps/Keyword.hpp>
+#include <ecsps/Profiler.hpp>
+#include "VelocityComponent.hpp"
+
+namespace ecsps
+{
+
+struct MovementInputComponent
+{
+    float movementSpeed{};
+};
+
+struct CharacterState
+{
+    Keyword state = "idle"_k;
+    Keyword direction = "right"_k;
+};
+
+class InputSystem
+{
+public:
+    enum Button : InputRecording::Buttons
+    {
+        leftButton = 1,
+        rightButton = 2,
+        jumpButton = 4,
+        shootButton = 8
+    };
+
+    template <typename EntitySystem>
+    void apply(EntitySystem& entitySystem)
+    {
+        ECSPS_PROFILE_SCOPE("InputSystem::apply");
+        entitySystem.template modify<const MovementInputComponent, CharacterState, VelocityComponent>()([&](const auto& input, auto& state, auto& velocity)
+        {
+            state.state = shouldJump ? "jumping"_k : (movingRight != movingLeft ? "running"_k : (shouldShoot ? "shooting"_k : "idle"_k));
+            if (movingRight != movingLeft)
+                state.direction = movingRight ? "right"_k : "left"_k;
+            velocity.velocity[0] = 0;
+            if (movingRight)
+                velocity.velocity[0] += input.movementSpeed;
+            if (movingLeft)
+                velocity.velocity[0] -= input.movementSpeed;
+            if (shouldJump)
+                velocity.velocity[1] = -input.movementSpeed;
+        });
+    }
+
+    void moveLeft(bool yes) { movingLeft = yes; }
+    void moveRight(bool yes) { movingRight = yes; }
+    void jump(bool yes) { shouldJump = yes; }
+    void shoot(bool yes) { shouldShoot = yes; }
+
+    InputRecording::Buttons buttons() const
+    {
+        using Buttons = InputRecording::Buttons;
+        return (movingLeft ? Buttons(leftButton) : Buttons(0)) | (movingRight ? Buttons(rightButton) : Buttons(0)) |
+            (shouldJump ? Buttons(jumpButton) : Buttons(0)) | (shouldShoot ? Buttons(shootButton) : Buttons(0));
+    }
+
+    void setButtons(InputRecording::Buttons buttons)
+    {
+        movingLeft = buttons & leftButton;
+        movingRight = buttons & rightButton;
+        shouldJump = buttons & jumpButton;
+        shouldShoot = buttons & shootButton;
+    }
+
+private:
+    bool movingRight = false;
+    bool movingLeft = false;
+    bool shouldJump = false;
+    bool shouldShoot = false;
+};
+
+}
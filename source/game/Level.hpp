@@ -0,0 +1,81 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include <ecsps/Entity.hpp>
+#include <ecsps/Keyword.hpp>
+#include "AnimationSystem.hpp"
+#include "CharacterAnimationSystem.hpp"
+#include "InputSystem.hpp"
+#include "PhysicsSystem.hpp"
+#include "SpriteComponent.hpp"
+#include "TransformComponent.hpp"
+#include "VelocityComponent.hpp"
+
+namespace ecsps
+{
+
+inline std::vector<std::pair<Keyword, Animation>> characterAnimations()
+{
+    return {
+        {"run_r"_k, Animation{frameNames("run_r_", 8), true, 15}},
+        {"run_l"_k, Animation{frameNames("run_l_", 8), true, 15}},
+        {"idle_r"_k, Animation{frameNames("idle_r_", 10), true, 15}},
+        {"idle_l"_k, Animation{frameNames("idle_l_", 10), true, 15}},
+        {"jump_r"_k, Animation{frameNames("jump_r_", 10), false, 15}},
+        {"jump_l"_k, Animation{frameNames("jump_l_", 10), false, 15}},
+        {"shoot_r"_k, Animation{frameNames("shoot_r_", 3), true, 15}},
+        {"shoot_l"_k, Animation{frameNames("shoot_l_", 3), true, 15}}
+    };
+}
+
+template <typename EntitySystem>
+Entity createLevel(EntitySystem& entitySystem)
+{
+    std::vector<std::pair<SpriteComponent, TransformComponent>> spriteComponents = {
+        {{"tree"_k, 2}, {{0, 832}}},
+        {{"grass"_k, 2}, {{256, 704}}},
+        {{"cactus"_k, 2}, {{1152, 832}}},
+        {{"background"_k, 0}, {{0, 0}}},
+        {{"background"_k, 0}, {{1280, 0}}},
+    };
+
+    std::vector<std::pair<SpriteComponent, TransformComponent>> tiles = {
+        {{"tile2"_k, 1}, {{0, 832}}},
+        {{"tile7"_k, 1}, {{128, 832}}},
+        {{"tile8"_k, 1}, {{256, 832}}},
+        {{"tile6"_k, 1}, {{384, 832}}},
+
+        {{"tile1"_k, 1}, {{256, 704}}},
+        {{"tile3"_k, 1}, {{384, 704}}},
+
+        {{"tile14"_k, 1}, {{640, 576}}},
+        {{"tile15"_k, 1}, {{768, 576}}},
+        {{"tile16"_k, 1}, {{896, 576}}},
+
+        {{"tile1"_k, 1}, {{1152, 832}}},
+
+        {{"tile2"_k, 1}, {{1280, 832}}},
+        {{"tile2"_k, 1}, {{1280 + 128, 832}}},
+        {{"tile2"_k, 1}, {{1280 + 256, 832}}},
+        {{"tile2"_k, 1}, {{1280 + 384, 832}}},
+    };
+
+    for (auto& c : spriteComponents)
+        entitySystem.createEntity(c.first, c.second);
+
+    for (auto& c : tiles)
+        entitySystem.createEntity(c.first, c.second, StaticColliderComponent{{128, 128}, {0, 0}});
+
+    return entitySystem.createEntity(
+        SpriteComponent{"idle_r_1"_k, 3},
+        AnimationComponent{"idle_r"_k, 0},
+        CharacterAnimation{"idle_l"_k, "idle_r"_k, "run_l"_k, "run_r"_k, "jump_l"_k, "jump_r"_k, "shoot_l"_k, "shoot_r"_k},
+        CharacterState{},
+        TransformComponent{{100, 822}},
+        VelocityComponent{{100, -400}},
+        GravityComponent{1200},
+        ColliderComponent{{70, 129}, {24, 128}},
+        MovementInputComponent{400});
+}
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <memory>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <ecsps/Math.hpp>
+#include <ecsps/Profiler.hpp>
+#include <ecsps/SpatialGrid.hpp>
+#include <ecsps/ThreadPool.hpp>
+#include "TransformComponent.hpp"
+#include "VelocityComponent.hpp"
+
+namespace ecsps
+{
+
+struct StaticColliderComponent
+{
+    vec2f size;
+    vec2f anchor;
+};
+
+struct ColliderComponent
+{
+    vec2f size;
+    vec2f anchor;
+};
+
+struct GravityComponent
+{
+    float gravity;
+};
+
+class PhysicsSystem
+{
+public:
+    PhysicsSystem(std::shared_ptr<ThreadPool> threadPool, float cellSize = 128)
+        : threadPool(std::move(threadPool)), statics(cellSize) { }
+
+    template <typename EntitySystem>
+    void step(EntitySystem& entitySystem, float delta)
+    {
+        ECSPS_PROFILE_SCOPE("PhysicsSystem::step");
+        updateStatics(entitySystem);
+        entitySystem.template parallelModify<TransformComponent, VelocityComponent>(*threadPool)([&](auto& transformComponent, auto& velocityComponent)
+        {
+            velocityComponent.previousPosition = transformComponent.position;
+            transformComponent.position += velocityComponent.velocity * delta;
+        });
+        entitySystem.template modify<TransformComponent, VelocityComponent, const GravityComponent>()([&](auto& transformComponent, auto& velocityComponent, const auto& gravityComponent)
+        {
+            transformComponent.position += vec2f{0, gravityComponent.gravity * delta * delta / 2};
+            velocityComponent.velocity += vec2f{0, gravityComponent.gravity * delta};
+        });
+        entitySystem.template modify<TransformComponent, VelocityComponent, const GravityComponent, const ColliderComponent>()([&](auto& transformComponent, auto& velocityComponent, const auto& , const auto& collider)
+        {
+            vec2f dynSize = collider.size;
+            vec2f prevPos = velocityComponent.previousPosition - collider.anchor;
+            vec2f areaPos = transformComponent.position - collider.anchor;
+            vec2f areaSize = dynSize + vec2f{std::abs(areaPos[0] - prevPos[0]), std::abs(areaPos[1] - prevPos[1])};
+            areaPos = {std::min(areaPos[0], prevPos[0]), std::min(areaPos[1], prevPos[1])};
+            statics.query(areaPos, areaSize, [&](const StaticBox& box)
+            {
+                vec2f dynPos = transformComponent.position - collider.anchor;
+                vec2f staPos = box.position;
+                vec2f staSize = box.size;
+
+                if (collides(dynPos, dynSize, staPos, staSize))
+                {
+                    if (!collides({dynPos[0], prevPos[1]}, dynSize, staPos, staSize))
+                    {
+                        dynPos[1] = prevPos[1];
+                        velocityComponent.velocity[1] = 0;
+                    }
+                    else if (!collides({prevPos[0], dynPos[1]}, dynSize, staPos, staSize))
+                    {
+                        dynPos[0] = prevPos[0];
+                        velocityComponent.velocity[0] = 0;
+                    }
+                    else
+                    {
+                        dynPos = prevPos;
+                        velocityComponent.velocity = {0, 0};
+                    }
+                    transformComponent.position = dynPos + collider.anchor;
+                }
+            });
+        });
+    }
+
+private:
+    struct StaticBox
+    {
+        vec2f position;
+        vec2f size;
+    };
+
+    std::shared_ptr<ThreadPool> threadPool;
+    SpatialGrid<StaticBox> statics;
+    std::uint64_t staticsVersion = std::numeric_limits<std::uint64_t>::max();
+
+    template <typename EntitySystem>
+    void updateStatics(const EntitySystem& entitySystem)
+    {
+        auto version = entitySystem.loadEpoch() + entitySystem.template version<TransformComponent, StaticColliderComponent>();
+        if (version == staticsVersion)
+            return;
+        staticsVersion = version;
+        statics.clear();
+        entitySystem.template view<const TransformComponent, const StaticColliderComponent>()([&](const auto& staticTransform, const auto& staticCollider)
+        {
+            vec2f position = staticTransform.position - staticCollider.anchor;
+            statics.insert(position, staticCollider.size, StaticBox{position, staticCollider.size});
+        });
+    }
+
+    static bool collides(vec2f pos1, vec2f size1, vec2f pos2, vec2f size2)
+    {
+        return
+            pos1[0] + size1[0] > pos2[0] && pos1[0] < pos2[0] + size2[0] &&
+            pos1[1] + size1[1] > pos2[1] && pos1[1] < pos2[1] + size2[1];
+    }
+};
+
+}
@@ -1,45 +1,44 @@
 #pragma once
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <SFML/Window.hpp>
 #include <SFML/Graphics.hpp>
 #include <ecsps/ResourcePool.hpp>
 #include <ecsps/Keyword.hpp>
+#include <ecsps/KeywordMap.hpp>
 #include <ecsps/Math.hpp>
+#include <ecsps/Profiler.hpp>
+#include <ecsps/RenderQueue.hpp>
+#include <ecsps/SpatialGrid.hpp>
+#include <ecsps/SpriteBatch.hpp>
+#include "AnimationSystem.hpp"
+#include "SpriteComponent.hpp"
+#include "SpriteDesc.hpp"
 #include "TransformComponent.hpp"
+#include "VelocityComponent.hpp"
 
 namespace ecsps
 {
 
 using TexturePool = ResourcePool<std::string, sf::Texture>;
 
-struct SpriteDesc
-{
-    std::string texture;
-    vec2i anchor;
-    bool mirrored{};
-    SpriteDesc(std::string texture, vec2i anchor, bool mirrored = false)
-        : texture(std::move(texture)), anchor(anchor), mirrored(mirrored) { }
-};
-
 struct Sprite
 {
     std::shared_ptr<const sf::Texture> texture;
+    std::uint16_t textureId;
     vec2i anchor;
     bool mirrored{};
+    vec2f texturePosition;
+    vec2f size;
 
-    Sprite(std::shared_ptr<const sf::Texture> texture, const vec2i& anchor, bool mirrored)
-        : texture(std::move(texture)), anchor(anchor), mirrored(mirrored) { }
-};
-
-using Bin = unsigned short;
-
-struct SpriteComponent
-{
-    Keyword name;
-    Bin bin;
-
-    SpriteComponent(Keyword name, Bin bin)
-        : name(std::move(name)), bin(bin) { }
+    Sprite(std::shared_ptr<const sf::Texture> texture, std::uint16_t textureId, const vec2i& anchor, bool mirrored, const vec2i& texturePosition, const vec2i& size)
+        : texture(std::move(texture)), textureId(textureId), anchor(anchor), mirrored(mirrored),
+          texturePosition(float(texturePosition[0]), float(texturePosition[1])), size(float(size[0]), float(size[1]))
+    {
+        if (size == vec2i(0, 0))
+            this->size = vec2f(float(this->texture->getSize().x), float(this->texture->getSize().y));
+    }
 };
 
 struct ViewComponent
@@ -52,17 +51,28 @@ class RenderSystem
 {
 public:
     RenderSystem(std::shared_ptr<sf::RenderWindow> window, std::shared_ptr<TexturePool> texturePool)
-        : window(window), texturePool(texturePool) { }
+        : window(window), texturePool(texturePool), backend{*window} { }
 
     void loadSprites(std::vector<std::pair<Keyword, SpriteDesc>> spriteDescs)
     {
+        std::vector<TexturePool::Future> textures;
         for (auto& desc : spriteDescs)
-            sprites.insert({desc.first, Sprite{texturePool->get(desc.second.texture), desc.second.anchor, desc.second.mirrored}});
+            textures.push_back(texturePool->getAsync(desc.second.texture));
+        for (std::size_t i = 0; i < spriteDescs.size(); ++i)
+        {
+            auto& desc = spriteDescs[i];
+            auto texture = texturePool->wait(textures[i]);
+            auto textureId = textureIds.insert({texture.get(), std::uint16_t(textureIds.size())}).first->second;
+            sprites.insert({desc.first, Sprite{std::move(texture), textureId, desc.second.anchor, desc.second.mirrored, desc.second.texturePosition, desc.second.size}});
+        }
     }
 
     template <typename EntitySystem>
-    void render(const EntitySystem& es)
+    void render(const EntitySystem& es, float alpha = 1)
     {
+        ECSPS_PROFILE_SCOPE("RenderSystem::render");
+        updateSpriteIndex(es);
+
         window->clear();
 
         es.template query<ViewComponent>()([&](const ViewComponent& viewComponent)
@@ -70,37 +80,117 @@ public:
             sf::View view{viewComponent.view};
             view.setViewport(viewComponent.viewport);
             window->setView(view);
-            for (unsigned bin = 0, binCount = 1; bin < binCount; ++bin)
+
+            vec2f viewPosition(viewComponent.view.left, viewComponent.view.top);
+            vec2f viewSize(viewComponent.view.width, viewComponent.view.height);
+            queue.clear();
+            staticSprites.query(viewPosition, viewSize, [&](Entity entity)
+            {
+                enqueueVisible(es, entity, alpha, viewPosition, viewSize);
+            });
+            for (auto entity : dynamicSprites)
+                enqueueVisible(es, entity, alpha, viewPosition, viewSize);
+            queue.sort();
+
+            auto bin = queue.empty() ? 0 : queue.bin(queue.begin()->key);
+            for (auto& item : queue)
             {
-                es.template query<TransformComponent, SpriteComponent>()([&](const TransformComponent& transformComponent, const SpriteComponent& spriteComponent)
+                if (queue.bin(item.key) != bin)
                 {
-                    binCount = std::max<Bin>(binCount, spriteComponent.bin + 1);
-                    if (spriteComponent.bin != bin)
-                        return;
-                    auto& sprite = sprites.at(spriteComponent.name);
-                    sf::Sprite ss{*sprite.texture};
-                    if (sprite.mirrored)
-                    {
-                        ss.setScale(-1, 1);
-                        ss.setOrigin(sprite.texture->getSize().x - sprite.anchor[0], sprite.anchor[1]);
-                    }
-                    else
-                    {
-                        ss.setOrigin(sprite.anchor[0], sprite.anchor[1]);
-                    }
-                    auto position = transformComponent.position;
-                    ss.setPosition(position[0], position[1]);
-                    window->draw(ss);
-                });
+                    batch.flush(backend);
+                    bin = queue.bin(item.key);
+                }
+                auto& sprite = *item.payload.sprite;
+                batch.add(*sprite.texture, item.payload.position, sprite.size, sprite.texturePosition, sprite.mirrored);
             }
+            batch.flush(backend);
         });
 
+        ECSPS_PROFILE_SCOPE("RenderSystem::display");
         window->display();
     }
+
 private:
+    struct VertexArrayBackend
+    {
+        sf::RenderTarget& target;
+        sf::VertexArray vertices{sf::Quads};
+
+        void draw(const sf::Texture& texture, const SpriteVertex *spriteVertices, std::size_t count)
+        {
+            vertices.resize(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                auto& vertex = spriteVertices[i];
+                vertices[i].position = {vertex.position[0], vertex.position[1]};
+                vertices[i].texCoords = {vertex.texCoords[0], vertex.texCoords[1]};
+            }
+            target.draw(vertices, &texture);
+        }
+    };
+
+    struct QueuedSprite
+    {
+        const Sprite *sprite;
+        vec2f position;
+    };
+
     std::shared_ptr<sf::RenderWindow> window;
     std::shared_ptr<TexturePool> texturePool;
-    std::unordered_map<Keyword, Sprite> sprites;
+    KeywordMap<Sprite> sprites;
+    std::unordered_map<const sf::Texture *, std::uint16_t> textureIds;
+    RenderQueue<QueuedSprite> queue;
+    SpriteBatch<sf::Texture> batch;
+    VertexArrayBackend backend;
+    SpatialGrid<Entity> staticSprites{256};
+    // Moving sprites are culled one by one every frame; indexing them would mean rebuilding a grid every frame.
+    std::vector<Entity> dynamicSprites;
+    std::uint64_t spriteIndexVersion = std::numeric_limits<std::uint64_t>::max();
+
+    static vec2f anchor(const Sprite& sprite)
+    {
+        return vec2f(float(sprite.anchor[0]), float(sprite.anchor[1]));
+    }
+
+    template <typename EntitySystem>
+    void updateSpriteIndex(const EntitySystem& es)
+    {
+        auto version =
+            es.loadEpoch() +
+            es.template version<TransformComponent, SpriteComponent>() +
+            es.template membershipVersion<TransformComponent, SpriteComponent, VelocityComponent>() +
+            es.template membershipVersion<TransformComponent, SpriteComponent, AnimationComponent>();
+        if (version == spriteIndexVersion)
+            return;
+        spriteIndexVersion = version;
+        staticSprites.clear();
+        dynamicSprites.clear();
+        es.template queryEntities<TransformComponent, SpriteComponent>()([&](Entity entity, const TransformComponent& transformComponent, const SpriteComponent& spriteComponent)
+        {
+            if (es.template has<VelocityComponent>(entity) || es.template has<AnimationComponent>(entity))
+            {
+                dynamicSprites.push_back(entity);
+                return;
+            }
+            auto& sprite = sprites.at(spriteComponent.name);
+            staticSprites.insert(transformComponent.position - anchor(sprite), sprite.size, entity);
+        });
+    }
+
+    template <typename EntitySystem>
+    void enqueueVisible(const EntitySystem& es, Entity entity, float alpha, const vec2f& viewPosition, const vec2f& viewSize)
+    {
+        auto transformComponent = es.template find<TransformComponent>(entity);
+        auto spriteComponent = es.template find<SpriteComponent>(entity);
+        if (!transformComponent || !spriteComponent)
+            return;
+        auto& sprite = sprites.at(spriteComponent->name);
+        auto position = interpolatedPosition(es, entity, *transformComponent, alpha) - anchor(sprite);
+        if (position[0] >= viewPosition[0] + viewSize[0] || position[0] + sprite.size[0] <= viewPosition[0] ||
+            position[1] >= viewPosition[1] + viewSize[1] || position[1] + sprite.size[1] <= viewPosition[1])
+            return;
+        queue.push(spriteComponent->bin, sprite.textureId, {&sprite, position});
+    }
 };
 
 }
@@ -0,0 +1,133 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ecsps/Entity.hpp>
+#include <ecsps/Keyword.hpp>
+#include <ecsps/Math.hpp>
+#include "AnimationSystem.hpp"
+#include "CharacterAnimationSystem.hpp"
+#include "InputSystem.hpp"
+#include "PhysicsSystem.hpp"
+#include "SpriteComponent.hpp"
+#include "TransformComponent.hpp"
+#include "VelocityComponent.hpp"
+
+namespace ecsps
+{
+
+struct SceneConfig
+{
+    // Floor tiles; each row of tiles also gets a wall tile at both ends.
+    std::size_t tiles = 1000;
+    std::size_t characters = 100;
+    float sparsity = 0;
+    std::uint32_t seed = 1;
+};
+
+struct Scene
+{
+    std::vector<Entity> characters;
+    std::size_t staticColliders = 0;
+    vec2f size;
+};
+
+class SceneGenerator
+{
+public:
+    explicit SceneGenerator(const SceneConfig& config) : config(config), random(config.seed) { }
+
+    template <typename EntitySystem>
+    Scene generate(EntitySystem& entitySystem)
+    {
+        Scene scene;
+        auto tilesPerRow = std::max<std::size_t>(16, std::size_t(std::sqrt(float(config.tiles)) * 4));
+        auto rows = std::max<std::size_t>(1, (config.tiles + tilesPerRow - 1) / tilesPerRow);
+        scene.size = vec2f(tilesPerRow * tileSize, rows * rowSpacing + tileSize);
+
+        for (std::size_t i = 0; i < config.tiles; ++i)
+        {
+            vec2f position((i % tilesPerRow) * tileSize, rowY(i / tilesPerRow));
+            entitySystem.createEntity(SpriteComponent{"tile2"_k, 1}, TransformComponent{position}, StaticColliderComponent{{tileSize, tileSize}, {0, 0}});
+        }
+        for (std::size_t row = 0; row < rows && config.tiles > 0; ++row)
+        {
+            auto width = rowTiles(row, tilesPerRow) * tileSize;
+            entitySystem.createEntity(SpriteComponent{"tile1"_k, 1}, TransformComponent{{-tileSize, rowY(row) - tileSize}}, StaticColliderComponent{{tileSize, tileSize}, {0, 0}});
+            entitySystem.createEntity(SpriteComponent{"tile3"_k, 1}, TransformComponent{{width, rowY(row) - tileSize}}, StaticColliderComponent{{tileSize, tileSize}, {0, 0}});
+            scene.staticColliders += 2;
+        }
+        scene.staticColliders += config.tiles;
+
+        scene.characters.reserve(config.characters);
+        for (std::size_t i = 0; i < config.characters; ++i)
+        {
+            auto row = std::size_t(unit() * rows);
+            auto width = std::max<std::size_t>(rowTiles(row, tilesPerRow), 1) * tileSize;
+            vec2f position(unit() * (width - tileSize) + tileSize / 2, rowY(row) - unit() * rowSpacing / 2);
+            vec2f velocity((unit() * 2 - 1) * 200, -unit() * 400);
+            auto character = entitySystem.createEntity(
+                SpriteComponent{"idle_r_1"_k, 3},
+                TransformComponent{position},
+                VelocityComponent{velocity, position});
+            if (present())
+                entitySystem.addComponents(character,
+                    AnimationComponent{"idle_r"_k, unit()},
+                    CharacterAnimation{"idle_l"_k, "idle_r"_k, "run_l"_k, "run_r"_k, "jump_l"_k, "jump_r"_k, "shoot_l"_k, "shoot_r"_k},
+                    CharacterState{},
+                    MovementInputComponent{400});
+            if (present())
+                entitySystem.addComponents(character, ColliderComponent{{70, 129}, {24, 128}});
+            if (present())
+                entitySystem.addComponents(character, GravityComponent{1200});
+            scene.characters.push_back(character);
+        }
+        return scene;
+    }
+
+private:
+    const float tileSize = 128;
+    const float rowSpacing = 512;
+
+    SceneConfig config;
+    std::mt19937 random;
+
+    float rowY(std::size_t row) const
+    {
+        return rowSpacing + row * rowSpacing;
+    }
+
+    std::size_t rowTiles(std::size_t row, std::size_t tilesPerRow) const
+    {
+        return std::min(tilesPerRow, config.tiles - std::min(config.tiles, row * tilesPerRow));
+    }
+
+    float unit()
+    {
+        return (random() >> 8) * (1.0f / 16777216);
+    }
+
+    bool present()
+    {
+        return unit() >= config.sparsity;
+    }
+};
+
+inline std::string sceneId(const SceneConfig& config)
+{
+    std::ostringstream id;
+    id << "generated tiles=" << config.tiles << " characters=" << config.characters << " sparsity=" << config.sparsity << " seed=" << config.seed;
+    return id.str();
+}
+
+template <typename EntitySystem>
+Scene generateScene(EntitySystem& entitySystem, const SceneConfig& config)
+{
+    return SceneGenerator{config}.generate(entitySystem);
+}
+
+}
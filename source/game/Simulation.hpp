@@ -0,0 +1,68 @@
+#pragma once
+#include <memory>
+#include <utility>
+#include <vector>
+#include <ecsps/Scheduler.hpp>
+#include <ecsps/ThreadPool.hpp>
+#include "AnimationSystem.hpp"
+#include "CharacterAnimationSystem.hpp"
+#include "InputSystem.hpp"
+#include "PhysicsSystem.hpp"
+#include "SpriteComponent.hpp"
+#include "TransformComponent.hpp"
+#include "VelocityComponent.hpp"
+
+namespace ecsps
+{
+
+template <template <typename...> class T, typename... ExtraComponents>
+using SimulationComponents = T<
+    TransformComponent,
+    SpriteComponent,
+    AnimationComponent,
+    StaticColliderComponent,
+    ColliderComponent,
+    VelocityComponent,
+    GravityComponent,
+    MovementInputComponent,
+    CharacterAnimation,
+    CharacterState,
+    ExtraComponents...>;
+
+class Simulation
+{
+public:
+    Simulation(std::shared_ptr<ThreadPool> threadPool, std::vector<std::pair<Keyword, Animation>> animations)
+        : physicsSystem{std::move(threadPool)}, animationSystem{std::move(animations)} { }
+
+    InputSystem& input() { return inputSystem; }
+
+    template <typename Scheduler, typename EntitySystem>
+    void schedule(Scheduler& scheduler, EntitySystem& entitySystem, const float& delta)
+    {
+        scheduler.add(
+            Reads<GravityComponent, ColliderComponent, StaticColliderComponent>{},
+            Writes<TransformComponent, VelocityComponent>{},
+            [&] { physicsSystem.step(entitySystem, delta); });
+        scheduler.add(
+            Reads<MovementInputComponent>{},
+            Writes<CharacterState, VelocityComponent>{},
+            [&] { inputSystem.apply(entitySystem); });
+        scheduler.add(
+            Reads<CharacterAnimation, CharacterState, VelocityComponent>{},
+            Writes<AnimationComponent>{},
+            [&] { characterAnimationSystem.apply(entitySystem); });
+        scheduler.add(
+            Reads<>{},
+            Writes<SpriteComponent, AnimationComponent>{},
+            [&] { animationSystem.step(entitySystem, delta); });
+    }
+
+private:
+    PhysicsSystem physicsSystem;
+    InputSystem inputSystem;
+    CharacterAnimationSystem characterAnimationSystem;
+    AnimationSystem animationSystem;
+};
+
+}
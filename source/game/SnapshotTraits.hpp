@@ -0,0 +1,50 @@
+#pragma once
+#include <type_traits>
+#include <ecsps/Snapshot.hpp>
+#include "AnimationSystem.hpp"
+#include "CharacterAnimationSystem.hpp"
+#include "InputSystem.hpp"
+#include "PhysicsSystem.hpp"
+#include "SpriteComponent.hpp"
+#include "TransformComponent.hpp"
+#include "VelocityComponent.hpp"
+
+namespace ecsps
+{
+
+template <> struct IsSnapshotBitwise<TransformComponent> : std::true_type { };
+template <> struct IsSnapshotBitwise<VelocityComponent> : std::true_type { };
+template <> struct IsSnapshotBitwise<StaticColliderComponent> : std::true_type { };
+template <> struct IsSnapshotBitwise<ColliderComponent> : std::true_type { };
+
+template <> struct IsKeywordFree<TransformComponent> : std::true_type { };
+template <> struct IsKeywordFree<VelocityComponent> : std::true_type { };
+template <> struct IsKeywordFree<StaticColliderComponent> : std::true_type { };
+template <> struct IsKeywordFree<ColliderComponent> : std::true_type { };
+template <> struct IsKeywordFree<GravityComponent> : std::true_type { };
+template <> struct IsKeywordFree<MovementInputComponent> : std::true_type { };
+
+inline void remapKeywords(SpriteComponent& sprite, const KeywordRemap& remap)
+{
+    sprite.name = remap(sprite.name);
+}
+
+inline void remapKeywords(AnimationComponent& animation, const KeywordRemap& remap)
+{
+    animation.animation = remap(animation.animation);
+}
+
+inline void remapKeywords(CharacterState& state, const KeywordRemap& remap)
+{
+    state.state = remap(state.state);
+    state.direction = remap(state.direction);
+}
+
+inline void remapKeywords(CharacterAnimation& character, const KeywordRemap& remap)
+{
+    for (auto keyword : {&character.idle_left, &character.idle_right, &character.run_left, &character.run_right,
+                         &character.jump_left, &character.jump_right, &character.shoot_left, &character.shoot_right})
+        *keyword = remap(*keyword);
+}
+
+}
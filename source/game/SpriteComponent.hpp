@@ -0,0 +1,18 @@
+#pragma once
+#include <ecsps/Keyword.hpp>
+
+namespace ecsps
+{
+
+using Bin = unsigned short;
+
+struct SpriteComponent
+{
+    Keyword name;
+    Bin bin;
+
+    SpriteComponent(Keyword name, Bin bin)
+        : name(std::move(name)), bin(bin) { }
+};
+
+}
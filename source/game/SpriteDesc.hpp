@@ -0,0 +1,56 @@
+#pragma once
+#include <ecsps/Keyword.hpp>
+#include <ecsps/Math.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ecsps
+{
+
+struct SpriteDesc
+{
+    std::string texture;
+    vec2i anchor;
+    bool mirrored{};
+    vec2i texturePosition;
+    vec2i size;
+    SpriteDesc(std::string texture, vec2i anchor, bool mirrored = false, vec2i texturePosition = {0, 0}, vec2i size = {0, 0})
+        : texture(std::move(texture)), anchor(anchor), mirrored(mirrored), texturePosition(texturePosition), size(size) { }
+};
+
+inline std::vector<std::pair<Keyword, SpriteDesc>> loadSpriteDescs(const std::string& filename)
+{
+    std::ifstream f(filename);
+    std::vector<std::pair<Keyword, SpriteDesc>> spriteDescs;
+    std::string line;
+
+    while (std::getline(f, line))
+    {
+        std::istringstream fields(line);
+        std::string name, path, mirror;
+        int anchorX{}, anchorY{}, x{}, y{}, width{}, height{};
+        if (!(fields >> name >> path >> anchorX >> anchorY >> mirror))
+            continue;
+        if (!(fields >> x >> y >> width >> height))
+            x = y = width = height = 0;
+        spriteDescs.push_back({Keyword{name}, {path, {anchorX, anchorY}, mirror == "true", {x, y}, {width, height}}});
+    }
+
+    return spriteDescs;
+}
+
+inline void saveSpriteDescs(const std::string& filename, const std::vector<std::pair<Keyword, SpriteDesc>>& spriteDescs)
+{
+    std::ofstream f(filename);
+    for (auto& desc : spriteDescs)
+        f << desc.first.str() << ' ' << desc.second.texture << ' '
+          << desc.second.anchor[0] << ' ' << desc.second.anchor[1] << ' '
+          << (desc.second.mirrored ? "true" : "false") << ' '
+          << desc.second.texturePosition[0] << ' ' << desc.second.texturePosition[1] << ' '
+          << desc.second.size[0] << ' ' << desc.second.size[1] << '\n';
+}
+
+}
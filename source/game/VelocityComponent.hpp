@@ -0,0 +1,24 @@
+#pragma once
+#include <ecsps/Entity.hpp>
+#include <ecsps/Math.hpp>
+#include "TransformComponent.hpp"
+
+namespace ecsps
+{
+
+struct VelocityComponent
+{
+    vec2f velocity;
+    vec2f previousPosition;
+};
+
+template <typename EntitySystem>
+vec2f interpolatedPosition(const EntitySystem& entitySystem, Entity entity, const TransformComponent& transform, float alpha)
+{
+    auto velocity = entitySystem.template find<VelocityComponent>(entity);
+    if (!velocity)
+        return transform.position;
+    return velocity->previousPosition + (transform.position - velocity->previousPosition) * alpha;
+}
+
+}
@@ -0,0 +1,212 @@
+#include "Level.hpp"
+#include "SceneGenerator.hpp"
+#include "Simulation.hpp"
+#include "SnapshotTraits.hpp"
+#include <ecsps/EntitySystem.hpp>
+#include <ecsps/Scheduler.hpp>
+#include <ecsps/InputRecording.hpp>
+#include <ecsps/Profiler.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+struct Options
+{
+    unsigned long steps = 100000;
+    unsigned threads = std::thread::hardware_concurrency();
+    bool generated = false;
+    std::string load;
+    std::string save;
+    std::string record;
+    std::string replay;
+    bool stepsGiven = false;
+    ecsps::SceneConfig scene;
+};
+
+bool option(const std::string& arg, const std::string& name, std::string& value)
+{
+    auto prefix = "--" + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0)
+        return false;
+    value = arg.substr(prefix.size());
+    return true;
+}
+
+Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i], value;
+        if (arg == "--generate")
+            options.generated = true;
+        else if (option(arg, "steps", value))
+        {
+            options.steps = std::stoul(value);
+            options.stepsGiven = true;
+        }
+        else if (option(arg, "threads", value))
+            options.threads = unsigned(std::stoul(value));
+        else if (option(arg, "load", value))
+            options.load = value;
+        else if (option(arg, "save", value))
+            options.save = value;
+        else if (option(arg, "record", value))
+            options.record = value;
+        else if (option(arg, "replay", value))
+            options.replay = value;
+        else if (option(arg, "tiles", value))
+            options.scene.tiles = std::stoul(value);
+        else if (option(arg, "characters", value))
+            options.scene.characters = std::stoul(value);
+        else if (option(arg, "sparsity", value))
+            options.scene.sparsity = std::stof(value);
+        else if (option(arg, "seed", value))
+            options.scene.seed = std::uint32_t(std::stoul(value));
+        else
+            throw std::invalid_argument("unknown option: " + arg);
+    }
+    return options;
+}
+
+template <typename EntitySystem>
+std::uint64_t stateChecksum(const EntitySystem& entitySystem)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&](const void *data, std::size_t size)
+    {
+        auto bytes = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < size; ++i)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+    };
+    entitySystem.template queryEntities<ecsps::TransformComponent>()([&](ecsps::Entity entity, const ecsps::TransformComponent& transform)
+    {
+        mix(&entity.index, sizeof(entity.index));
+        mix(transform.position.data(), 2 * sizeof(float));
+    });
+    entitySystem.template queryEntities<ecsps::AnimationComponent>()([&](ecsps::Entity entity, const ecsps::AnimationComponent& animation)
+    {
+        mix(&entity.index, sizeof(entity.index));
+        mix(&animation.time, sizeof(animation.time));
+        mix(animation.animation.str().data(), animation.animation.str().size());
+    });
+    return hash;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    using namespace ecsps;
+
+    Options options;
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        std::cerr << "usage: sim_headless [--steps=N] [--threads=N] [--load=snapshot] [--save=snapshot] [--record=input] [--replay=input] [--generate [--tiles=N] [--characters=N] [--sparsity=0..1] [--seed=N]]" << std::endl;
+        return 1;
+    }
+
+    SimulationComponents<EntitySystem> entitySystem;
+    std::string scene = "level";
+    if (!options.load.empty())
+    {
+        try
+        {
+            loadSnapshot(entitySystem, options.load);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        scene = "snapshot " + options.load;
+    }
+    else if (options.generated)
+    {
+        generateScene(entitySystem, options.scene);
+        scene = sceneId(options.scene);
+    }
+    else
+        createLevel(entitySystem);
+
+    auto threadPool = std::make_shared<ThreadPool>(options.threads);
+    Simulation simulation{threadPool, characterAnimations()};
+    auto& input = simulation.input();
+
+    const float delta = 1.0f / 60;
+    SimulationComponents<Scheduler> schedule{threadPool};
+    simulation.schedule(schedule, entitySystem, delta);
+
+    InputRecording replay, recording;
+    recording.setScene(scene);
+    if (!options.replay.empty())
+    {
+        try
+        {
+            std::ifstream is(options.replay);
+            if (!is)
+                throw std::runtime_error("cannot read " + options.replay);
+            replay = InputRecording::load(is);
+            replay.checkScene(scene);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        if (!options.stepsGiven)
+            options.steps = replay.length();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long step = 0; step < options.steps; ++step)
+    {
+        if (!options.replay.empty())
+            input.setButtons(replay.at(step));
+        else
+        {
+            input.moveRight(step % 240 < 120);
+            input.moveLeft(step % 240 >= 120);
+            input.jump(step % 90 == 0);
+            input.shoot(step % 300 >= 280);
+        }
+        if (!options.record.empty())
+            recording.record(step, input.buttons());
+
+        ECSPS_PROFILE_SCOPE("simulation");
+        schedule.run();
+    }
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "entities: " << entitySystem.view<TransformComponent>().size() << std::endl;
+    std::cout << "steps: " << options.steps << std::endl;
+    std::cout << "threads: " << threadPool->size() << std::endl;
+    std::cout << "time: " << seconds << " s" << std::endl;
+    std::cout << "steps/s: " << (seconds > 0 ? options.steps / seconds : 0) << std::endl;
+    std::cout << "checksum: " << std::hex << stateChecksum(entitySystem) << std::dec << std::endl;
+
+    if (!options.record.empty())
+    {
+        std::ofstream os(options.record);
+        recording.save(os);
+    }
+
+    if (!options.save.empty())
+        saveSnapshot(entitySystem, options.save);
+
+#ifdef ECSPS_PROFILING
+    std::ofstream trace("trace.json");
+    Profiler::instance().writeChromeTrace(trace);
+#endif
+}
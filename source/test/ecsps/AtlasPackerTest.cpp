@@ -0,0 +1,58 @@
+#include <ecsps/AtlasPacker.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+
+namespace ecsps
+{
+
+struct AtlasPackerTest : testing::Test
+{
+    static bool overlap(const AtlasPlacement& p1, const vec2i& s1, const AtlasPlacement& p2, const vec2i& s2)
+    {
+        return p1.page == p2.page &&
+            p1.position[0] < p2.position[0] + s2[0] && p2.position[0] < p1.position[0] + s1[0] &&
+            p1.position[1] < p2.position[1] + s2[1] && p2.position[1] < p1.position[1] + s1[1];
+    }
+};
+
+TEST_F(AtlasPackerTest, should_place_images_inside_pages_without_overlapping)
+{
+    std::mt19937 random(3);
+    std::vector<vec2i> sizes;
+    for (int i = 0; i < 200; ++i)
+        sizes.push_back(vec2i(int(random() % 200) + 1, int(random() % 150) + 1));
+    vec2i pageSize(512, 512);
+
+    auto placements = packAtlas(sizes, pageSize);
+
+    ASSERT_EQ(sizes.size(), placements.size());
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        ASSERT_GE(placements[i].position[0], 0);
+        ASSERT_GE(placements[i].position[1], 0);
+        ASSERT_LE(placements[i].position[0] + sizes[i][0], pageSize[0]);
+        ASSERT_LE(placements[i].position[1] + sizes[i][1], pageSize[1]);
+        for (std::size_t j = 0; j < i; ++j)
+            ASSERT_FALSE(overlap(placements[i], sizes[i], placements[j], sizes[j])) << i << " " << j;
+    }
+}
+
+TEST_F(AtlasPackerTest, should_start_a_new_page_when_a_page_is_full)
+{
+    auto placements = packAtlas({vec2i(64, 64), vec2i(64, 64), vec2i(64, 64)}, vec2i(64, 128), 0);
+
+    ASSERT_EQ(0u, placements[0].page);
+    ASSERT_EQ(vec2i(0, 0), placements[0].position);
+    ASSERT_EQ(0u, placements[1].page);
+    ASSERT_EQ(vec2i(0, 64), placements[1].position);
+    ASSERT_EQ(1u, placements[2].page);
+    ASSERT_EQ(vec2i(0, 0), placements[2].position);
+}
+
+TEST_F(AtlasPackerTest, should_reject_images_larger_than_a_page)
+{
+    ASSERT_THROW(packAtlas({vec2i(65, 10)}, vec2i(64, 64)), std::invalid_argument);
+}
+
+}
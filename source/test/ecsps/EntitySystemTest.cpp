@@ -0,0 +1,283 @@
+#include <ecsps/EntitySystem.hpp>
+#include <gtest/gtest.h>
+#include <numeric>
+#include "ecsps_test_query.hpp"
+
+namespace ecsps
+{
+
+struct EntitySystemTest : testing::Test
+{
+    struct A { int value; };
+    struct B { int value; };
+    struct C { int value; };
+    EntitySystem<A, B, C> es;
+
+    template <typename... Components>
+    std::vector<int> collect()
+    {
+        return collectSorted<Components...>(es, [](const auto& first) { return first.value; });
+    }
+};
+
+TEST_F(EntitySystemTest, should_query_only_entities_containing_all_requested_components)
+{
+    es.createEntity(A{1}, B{10});
+    es.createEntity(A{2});
+    es.createEntity(A{3}, B{30}, C{300});
+    es.createEntity(B{40}, C{400});
+
+    ASSERT_EQ((std::vector<int>{1, 2, 3}), collect<A>());
+    ASSERT_EQ((std::vector<int>{1, 3}), (collect<A, B>()));
+    ASSERT_EQ((std::vector<int>{30, 40}), (collect<B, C>()));
+    ASSERT_EQ((std::vector<int>{300}), (collect<C, A>()));
+}
+
+TEST_F(EntitySystemTest, should_pass_components_of_the_same_entity_together)
+{
+    for (int i = 0; i < 100; ++i)
+        if (i % 3)
+            es.createEntity(B{i * 2}, A{i});
+        else
+            es.createEntity(A{i}, C{i});
+
+    int count = 0;
+    es.query<A, B>()([&](const A& a, const B& b)
+    {
+        EXPECT_EQ(a.value * 2, b.value);
+        ++count;
+    });
+    ASSERT_EQ(66, count);
+}
+
+TEST_F(EntitySystemTest, should_modify_components_in_place)
+{
+    es.createEntity(A{1}, B{2});
+    es.createEntity(A{3});
+
+    es.modify<A>()([](A& a) { a.value *= 10; });
+
+    ASSERT_EQ((std::vector<int>{10, 30}), collect<A>());
+}
+
+TEST_F(EntitySystemTest, should_remove_components_from_an_entity)
+{
+    auto e1 = es.createEntity(A{1}, B{10});
+    es.createEntity(A{2}, B{20});
+
+    es.removeComponents<B>(e1);
+
+    ASSERT_EQ((std::vector<int>{1, 2}), collect<A>());
+    ASSERT_EQ((std::vector<int>{20}), collect<B>());
+    ASSERT_EQ((std::vector<int>{2}), (collect<A, B>()));
+}
+
+TEST_F(EntitySystemTest, should_add_components_to_an_existing_entity)
+{
+    auto e = es.createEntity(A{1});
+
+    es.addComponents(e, C{100}, B{10});
+
+    ASSERT_EQ((std::vector<int>{1}), (collect<A, B, C>()));
+}
+
+TEST_F(EntitySystemTest, should_destroy_entities_with_all_their_components)
+{
+    es.createEntity(A{1}, B{10});
+    auto e2 = es.createEntity(A{2}, C{200});
+    es.createEntity(A{3}, B{30}, C{300});
+
+    es.destroyEntity(e2);
+
+    ASSERT_EQ((std::vector<int>{1, 3}), collect<A>());
+    ASSERT_EQ((std::vector<int>{300}), collect<C>());
+    ASSERT_EQ((std::vector<int>{3}), (collect<A, C>()));
+}
+
+TEST_F(EntitySystemTest, should_provide_components_of_an_entity_by_its_handle)
+{
+    es.createEntity(A{1});
+    auto e = es.createEntity(A{2}, B{20});
+
+    ASSERT_EQ(2, es.get<A>(e).value);
+    ASSERT_EQ(20, es.get<B>(e).value);
+    ASSERT_TRUE(es.has<A>(e));
+    ASSERT_TRUE((es.has<A, B>(e)));
+    ASSERT_FALSE(es.has<C>(e));
+    ASSERT_THROW(es.get<C>(e), std::out_of_range);
+
+    es.get<A>(e).value = 5;
+    ASSERT_EQ((std::vector<int>{1, 5}), collect<A>());
+}
+
+TEST_F(EntitySystemTest, should_invalidate_handles_of_destroyed_entities)
+{
+    auto e = es.createEntity(A{1});
+    es.destroyEntity(e);
+
+    ASSERT_FALSE(es.alive(e));
+    ASSERT_FALSE(es.has<A>(e));
+    ASSERT_THROW(es.get<A>(e), std::out_of_range);
+    ASSERT_THROW(es.addComponents(e, B{1}), std::out_of_range);
+    es.destroyEntity(e);
+}
+
+TEST_F(EntitySystemTest, should_reuse_slots_of_destroyed_entities_with_a_new_generation)
+{
+    auto e1 = es.createEntity(A{1});
+    es.destroyEntity(e1);
+    auto e2 = es.createEntity(B{2});
+
+    ASSERT_EQ(e1.index, e2.index);
+    ASSERT_NE(e1, e2);
+    ASSERT_FALSE(es.alive(e1));
+    ASSERT_TRUE(es.alive(e2));
+    ASSERT_FALSE(es.has<B>(e1));
+    ASSERT_EQ(2, es.get<B>(e2).value);
+}
+
+TEST_F(EntitySystemTest, should_fill_cached_queries_with_entities_created_before_them)
+{
+    for (int i = 0; i < 10; ++i)
+        es.createEntity(A{i}, B{i});
+    es.createEntity(A{100}, B{100}, C{100});
+    es.createEntity(C{200});
+
+    ASSERT_EQ((std::vector<int>{100}), (collect<A, C, B>()));
+    ASSERT_EQ(1u, (es.view<C, B, A>().size()));
+    ASSERT_EQ(11u, (es.view<B, A>().size()));
+
+    auto plan = es.queryPlan<A, B, C>();
+    ASSERT_EQ(2u, plan.driverComponent);
+    ASSERT_EQ(1u, plan.candidateCount);
+
+    plan = es.queryPlan<B>();
+    ASSERT_EQ(1u, plan.driverComponent);
+    ASSERT_EQ(11u, plan.candidateCount);
+}
+
+TEST_F(EntitySystemTest, should_keep_views_up_to_date_when_entities_change)
+{
+    auto e1 = es.createEntity(A{1}, B{10});
+    auto e2 = es.createEntity(A{2});
+    auto view = es.view<A, B>();
+    ASSERT_EQ(1u, view.size());
+
+    es.addComponents(e2, B{20});
+    auto e3 = es.createEntity(B{30}, A{3});
+    ASSERT_EQ(3u, view.size());
+
+    es.removeComponents<B>(e1);
+    es.destroyEntity(e3);
+    es.createEntity(C{4});
+
+    std::vector<int> values;
+    view([&](A& a, B& b) { values.push_back(a.value + b.value); });
+    ASSERT_EQ((std::vector<int>{22}), values);
+    ASSERT_EQ((std::vector<int>{20}), (collect<B, A>()));
+}
+
+TEST_F(EntitySystemTest, should_cache_queries_separately_for_each_entity_system)
+{
+    es.createEntity(A{1}, B{10});
+    ASSERT_EQ((std::vector<int>{1}), (collect<A, B>()));
+
+    EntitySystem<A, B, C> other;
+    other.createEntity(B{20}, C{200});
+    other.createEntity(A{2}, B{30});
+    ASSERT_EQ(1u, (other.view<B, C>().size()));
+    ASSERT_EQ(1u, (other.view<A, B>().size()));
+    ASSERT_EQ(1u, (es.view<A, B>().size()));
+    ASSERT_EQ(0u, (es.view<B, C>().size()));
+}
+
+TEST_F(EntitySystemTest, should_provide_read_only_views_of_const_entity_systems)
+{
+    es.createEntity(A{1}, B{10});
+    const auto& ces = es;
+
+    int sum = 0;
+    ces.view<A, B>()([&](const A& a, const B& b) { sum += a.value + b.value; });
+    ASSERT_EQ(11, sum);
+}
+
+TEST_F(EntitySystemTest, should_change_query_versions_only_when_the_query_may_see_different_data)
+{
+    auto e1 = es.createEntity(A{1}, B{10});
+    es.createEntity(A{2});
+    auto version = es.version<A, B>();
+    auto membership = es.membershipVersion<A, B>();
+
+    es.query<A, B>()([](const A&, const B&) { });
+    es.modify<const A, const B>()([](const A&, const B&) { });
+    es.modify<C>()([](C&) { });
+    es.modify<B, C>()([](B&, C&) { });
+    es.createEntity(C{3});
+    ASSERT_EQ(version, (es.version<A, B>()));
+
+    es.modify<A>()([](A&) { });
+    ASSERT_NE(version, (es.version<A, B>()));
+    version = es.version<A, B>();
+
+    es.view<A, B>()([](A&, B&) { });
+    ASSERT_NE(version, (es.version<A, B>()));
+    version = es.version<A, B>();
+
+    es.addComponents(e1, B{20});
+    ASSERT_NE(version, (es.version<A, B>()));
+    ASSERT_EQ(membership, (es.membershipVersion<A, B>()));
+
+    es.destroyEntity(e1);
+    es.createEntity(A{4}, B{40});
+    ASSERT_NE(membership, (es.membershipVersion<A, B>()));
+}
+
+TEST_F(EntitySystemTest, parallel_modify_should_visit_each_matching_entity_once)
+{
+    ThreadPool threadPool{4};
+    for (int i = 0; i < 5000; ++i)
+        if (i % 5)
+            es.createEntity(A{i}, B{i});
+        else
+            es.createEntity(A{i});
+
+    es.parallelModify<A>(threadPool, 100)([](A& a) { a.value += 1; });
+    es.parallelModify<A, B>(threadPool, 100)([](A& a, B& b) { b.value = a.value * 2; });
+
+    int count = 0;
+    es.query<A, B>()([&](const A& a, const B& b)
+    {
+        EXPECT_EQ(a.value * 2, b.value);
+        ++count;
+    });
+    ASSERT_EQ(4000, count);
+    auto values = collect<A>();
+    ASSERT_EQ(5000 * 5001 / 2, std::accumulate(begin(values), end(values), 0));
+}
+
+TEST_F(EntitySystemTest, should_query_entity_handles_together_with_components)
+{
+    auto e1 = es.createEntity(A{1}, B{10});
+    es.createEntity(A{2});
+    auto e3 = es.createEntity(B{30}, A{3});
+
+    std::vector<Entity> entities;
+    es.queryEntities<A, B>()([&](Entity e, const A&, const B&) { entities.push_back(e); });
+    ASSERT_EQ((std::vector<Entity>{e1, e3}), entities);
+
+    entities.clear();
+    es.queryEntities<B>()([&](Entity e, const B&) { entities.push_back(e); });
+    ASSERT_EQ((std::vector<Entity>{e1, e3}), entities);
+}
+
+TEST_F(EntitySystemTest, find_should_return_null_for_missing_components)
+{
+    auto e = es.createEntity(A{1});
+
+    ASSERT_EQ(1, es.find<A>(e)->value);
+    ASSERT_EQ(nullptr, es.find<B>(e));
+    es.destroyEntity(e);
+    ASSERT_EQ(nullptr, es.find<A>(e));
+}
+
+}
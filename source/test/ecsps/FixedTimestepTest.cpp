@@ -0,0 +1,36 @@
+#include <ecsps/FixedTimestep.hpp>
+#include <gtest/gtest.h>
+
+namespace ecsps
+{
+
+struct FixedTimestepTest : testing::Test
+{
+    FixedTimestep timestep{0.25f, 3};
+    std::vector<float> steps;
+
+    unsigned advance(float elapsed)
+    {
+        return timestep.advance(elapsed, [&](float step) { steps.push_back(step); });
+    }
+};
+
+TEST_F(FixedTimestepTest, should_run_whole_steps_and_carry_the_remainder)
+{
+    ASSERT_EQ(0u, advance(0.125f));
+    ASSERT_FLOAT_EQ(0.5f, timestep.alpha());
+    ASSERT_EQ(1u, advance(0.25f));
+    ASSERT_FLOAT_EQ(0.5f, timestep.alpha());
+    ASSERT_EQ(2u, advance(0.375f));
+    ASSERT_FLOAT_EQ(0, timestep.alpha());
+    ASSERT_EQ((std::vector<float>{0.25f, 0.25f, 0.25f}), steps);
+}
+
+TEST_F(FixedTimestepTest, should_drop_time_it_cannot_catch_up_with)
+{
+    ASSERT_EQ(3u, advance(10));
+    ASSERT_FLOAT_EQ(0, timestep.alpha());
+    ASSERT_EQ(1u, advance(0.25f));
+}
+
+}
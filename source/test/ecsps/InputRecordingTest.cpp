@@ -0,0 +1,106 @@
+#include <ecsps/InputRecording.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace ecsps
+{
+
+TEST(InputRecordingTest, should_report_no_buttons_for_an_empty_recording)
+{
+    InputRecording recording;
+    ASSERT_EQ(0u, recording.length());
+    ASSERT_EQ(0u, recording.at(0));
+    ASSERT_EQ(0u, recording.at(1000));
+}
+
+TEST(InputRecordingTest, should_replay_the_buttons_recorded_for_each_step)
+{
+    InputRecording recording;
+    recording.record(0, 0);
+    recording.record(1, 1);
+    recording.record(2, 1);
+    recording.record(3, 5);
+    recording.record(4, 0);
+
+    ASSERT_EQ(5u, recording.length());
+    ASSERT_EQ(0u, recording.at(0));
+    ASSERT_EQ(1u, recording.at(1));
+    ASSERT_EQ(1u, recording.at(2));
+    ASSERT_EQ(5u, recording.at(3));
+    ASSERT_EQ(0u, recording.at(4));
+    ASSERT_EQ(0u, recording.at(100));
+}
+
+TEST(InputRecordingTest, should_store_only_changes)
+{
+    InputRecording recording;
+    for (std::uint64_t step = 0; step < 100; ++step)
+        recording.record(step, step < 50 ? 2 : 3);
+    ASSERT_EQ(2u, recording.changeCount());
+    ASSERT_EQ(100u, recording.length());
+}
+
+TEST(InputRecordingTest, should_keep_buttons_across_skipped_steps)
+{
+    InputRecording recording;
+    recording.record(10, 4);
+    recording.record(20, 8);
+    ASSERT_EQ(0u, recording.at(9));
+    ASSERT_EQ(4u, recording.at(15));
+    ASSERT_EQ(8u, recording.at(20));
+    ASSERT_EQ(21u, recording.length());
+}
+
+TEST(InputRecordingTest, should_reject_steps_recorded_out_of_order)
+{
+    InputRecording recording;
+    recording.record(5, 1);
+    ASSERT_THROW(recording.record(4, 2), std::invalid_argument);
+}
+
+TEST(InputRecordingTest, should_save_and_load_recordings)
+{
+    InputRecording recording;
+    recording.record(0, 1);
+    recording.record(7, 6);
+    recording.record(9, 6);
+    recording.setScene("generated tiles=10 seed=3");
+
+    std::stringstream stream;
+    recording.save(stream);
+    auto loaded = InputRecording::load(stream);
+
+    ASSERT_EQ("generated tiles=10 seed=3", loaded.scene());
+    ASSERT_EQ(recording.length(), loaded.length());
+    ASSERT_EQ(recording.changeCount(), loaded.changeCount());
+    for (std::uint64_t step = 0; step < 12; ++step)
+        ASSERT_EQ(recording.at(step), loaded.at(step));
+}
+
+TEST(InputRecordingTest, should_reject_malformed_recordings)
+{
+    std::istringstream wrongHeader("recording\nend 0\n");
+    ASSERT_THROW(InputRecording::load(wrongHeader), std::runtime_error);
+    std::istringstream oldVersion("ecsps-input 1\n0 1\nend 1\n");
+    ASSERT_THROW(InputRecording::load(oldVersion), std::runtime_error);
+    std::istringstream truncated("ecsps-input 2\nscene level\n0 1\n");
+    ASSERT_THROW(InputRecording::load(truncated), std::runtime_error);
+    std::istringstream outOfOrder("ecsps-input 2\nscene level\n5 1\n3 2\nend 6\n");
+    ASSERT_THROW(InputRecording::load(outOfOrder), std::runtime_error);
+    std::istringstream garbage("ecsps-input 2\nscene level\nx 1\nend 6\n");
+    ASSERT_THROW(InputRecording::load(garbage), std::runtime_error);
+    std::istringstream missingScene("ecsps-input 2\n0 1\nend 1\n");
+    ASSERT_THROW(InputRecording::load(missingScene), std::runtime_error);
+}
+
+TEST(InputRecordingTest, should_reject_replays_of_a_different_scene)
+{
+    InputRecording recording;
+    recording.setScene("level");
+    recording.checkScene("level");
+    ASSERT_THROW(recording.checkScene("generated tiles=10"), std::runtime_error);
+    ASSERT_THROW(recording.setScene("two\nlines"), std::invalid_argument);
+}
+
+}
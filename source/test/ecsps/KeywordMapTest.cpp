@@ -0,0 +1,53 @@
+#include <ecsps/KeywordMap.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ecsps
+{
+
+TEST(KeywordMapTest, should_map_keywords_to_values)
+{
+    KeywordMap<int> map{{"one"_k, 1}, {"two"_k, 2}};
+    ASSERT_EQ(2u, map.size());
+    ASSERT_EQ(1, map.at("one"_k));
+    ASSERT_EQ(2, map.at("two"_k));
+}
+
+TEST(KeywordMapTest, should_throw_for_unknown_keywords)
+{
+    KeywordMap<int> map{{"one"_k, 1}};
+    ASSERT_THROW(map.at("missing"_k), std::out_of_range);
+    ASSERT_THROW(map.at(Keyword("never_seen_before")), std::out_of_range);
+    ASSERT_TRUE(map.find("missing"_k) == nullptr);
+    ASSERT_FALSE(map.contains("missing"_k));
+}
+
+TEST(KeywordMapTest, should_not_replace_existing_values_on_insert)
+{
+    KeywordMap<std::string> map;
+    ASSERT_TRUE(map.insert({"key"_k, "first"}));
+    ASSERT_FALSE(map.insert({"key"_k, "second"}));
+    ASSERT_EQ("first", map.at("key"_k));
+}
+
+TEST(KeywordMapTest, should_create_default_values_on_subscript)
+{
+    KeywordMap<int> map;
+    ASSERT_EQ(0, map["counter"_k]);
+    map["counter"_k] += 5;
+    ASSERT_EQ(5, *map.find("counter"_k));
+    ASSERT_EQ(1u, map.size());
+}
+
+TEST(KeywordMapTest, should_be_constructible_from_a_range_of_pairs)
+{
+    std::vector<std::pair<Keyword, int>> pairs{{"a"_k, 1}, {"b"_k, 2}, {"a"_k, 3}};
+    KeywordMap<int> map{begin(pairs), end(pairs)};
+    ASSERT_EQ(2u, map.size());
+    ASSERT_EQ(1, map.at("a"_k));
+    ASSERT_EQ(2, map.at("b"_k));
+}
+
+}
@@ -1,5 +1,8 @@
 #include <ecsps/Keyword.hpp>
 #include <gtest/gtest.h>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace ecsps
 {
@@ -31,4 +34,60 @@ TEST(KeywordTest, should_provide_a_literal_operator)
     ASSERT_TRUE("word"_k == Keyword("word"));
 }
 
+TEST(KeywordTest, should_intern_a_literal_once)
+{
+    auto literal = [] () -> const Keyword& { return "once"_k; };
+    ASSERT_EQ(&literal(), &literal());
+    ASSERT_TRUE(""_k == Keyword());
+}
+
+TEST(KeywordTest, should_be_a_trivially_copyable_32_bit_id)
+{
+    ASSERT_EQ(4u, sizeof(Keyword));
+    ASSERT_TRUE(std::is_trivially_copyable<Keyword>::value);
+}
+
+TEST(KeywordTest, should_assign_dense_indices_to_names)
+{
+    ASSERT_EQ(0u, Keyword().index());
+    ASSERT_EQ("", Keyword().str());
+    Keyword a("dense_a"), b("dense_b");
+    ASSERT_NE(a.index(), b.index());
+    ASSERT_LT(a.index(), Keyword::count());
+    ASSERT_LT(b.index(), Keyword::count());
+    ASSERT_EQ(a.index(), Keyword("dense_a").index());
+}
+
+TEST(KeywordTest, should_keep_names_stable_while_the_table_grows)
+{
+    Keyword first("stable_0");
+    const std::string& name = first.str();
+    for (int i = 1; i < 5000; ++i)
+        Keyword("stable_" + std::to_string(i));
+    ASSERT_EQ(&name, &first.str());
+    ASSERT_EQ("stable_4999", Keyword("stable_4999").str());
+}
+
+TEST(KeywordTest, should_intern_the_same_names_to_the_same_ids_from_many_threads)
+{
+    const int nameCount = 1000;
+    std::vector<std::vector<Keyword>> results(4);
+    std::vector<std::thread> threads;
+    for (auto& result : results)
+        threads.emplace_back([&]
+        {
+            for (int i = 0; i < nameCount; ++i)
+                result.push_back(Keyword("threaded_" + std::to_string(i)));
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int i = 0; i < nameCount; ++i)
+    {
+        ASSERT_EQ("threaded_" + std::to_string(i), results[0][i].str());
+        for (auto& result : results)
+            ASSERT_TRUE(results[0][i] == result[i]);
+    }
+}
+
 }
@@ -0,0 +1,95 @@
+#include <ecsps/Profiler.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace ecsps
+{
+
+struct ProfilerTest : testing::Test
+{
+    Profiler profiler{8};
+    Profiler::Clock::time_point origin = Profiler::Clock::now();
+
+    void record(const char *name, int startUs, int durationUs)
+    {
+        auto start = origin + std::chrono::microseconds(startUs);
+        profiler.record(name, start, start + std::chrono::microseconds(durationUs));
+    }
+};
+
+TEST_F(ProfilerTest, should_record_spans_ordered_by_start_time)
+{
+    record("second", 20, 5);
+    record("first", 10, 30);
+
+    auto spans = profiler.spans();
+    ASSERT_EQ(2u, spans.size());
+    ASSERT_STREQ("first", spans[0].name);
+    ASSERT_STREQ("second", spans[1].name);
+    ASSERT_EQ(30000u, spans[0].duration);
+    ASSERT_EQ(10000u, spans[1].start - spans[0].start);
+}
+
+TEST_F(ProfilerTest, should_keep_only_the_latest_spans_when_the_buffer_wraps)
+{
+    const char *names[] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+    for (int i = 0; i < 10; ++i)
+        record(names[i], i, 1);
+
+    auto spans = profiler.spans();
+    ASSERT_EQ(8u, spans.size());
+    ASSERT_STREQ("2", spans.front().name);
+    ASSERT_STREQ("9", spans.back().name);
+}
+
+TEST_F(ProfilerTest, should_record_scopes)
+{
+    {
+        ProfileScope scope{"scope", profiler};
+    }
+    auto spans = profiler.spans();
+    ASSERT_EQ(1u, spans.size());
+    ASSERT_STREQ("scope", spans[0].name);
+}
+
+TEST_F(ProfilerTest, should_record_spans_from_many_threads)
+{
+    Profiler shared{1024};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&]
+        {
+            for (int i = 0; i < 100; ++i)
+                ProfileScope scope{"work", shared};
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    auto spans = shared.spans();
+    ASSERT_EQ(400u, spans.size());
+    for (auto& span : spans)
+        ASSERT_STREQ("work", span.name);
+}
+
+TEST_F(ProfilerTest, should_write_chrome_trace_events)
+{
+    record("a \"quoted\" name", 1, 2);
+    std::ostringstream os;
+    profiler.writeChromeTrace(os);
+    auto trace = os.str();
+    ASSERT_EQ(0u, trace.find("{\"traceEvents\":["));
+    ASSERT_NE(std::string::npos, trace.find("\"name\":\"a \\\"quoted\\\" name\""));
+    ASSERT_NE(std::string::npos, trace.find("\"ph\":\"X\""));
+    ASSERT_NE(std::string::npos, trace.find("\"dur\":2.000"));
+}
+
+TEST_F(ProfilerTest, should_forget_spans_on_clear)
+{
+    record("span", 0, 1);
+    profiler.clear();
+    ASSERT_TRUE(profiler.spans().empty());
+}
+
+}
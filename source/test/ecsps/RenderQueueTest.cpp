@@ -0,0 +1,66 @@
+#include <ecsps/RenderQueue.hpp>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace ecsps
+{
+
+struct RenderQueueTest : testing::Test
+{
+    RenderQueue<int> queue;
+
+    std::vector<int> payloads() const
+    {
+        std::vector<int> result;
+        for (auto& item : queue)
+            result.push_back(item.payload);
+        return result;
+    }
+};
+
+TEST_F(RenderQueueTest, should_sort_items_by_bin_and_then_by_texture)
+{
+    queue.push(2, 0, 1);
+    queue.push(0, 5, 2);
+    queue.push(1, 300, 3);
+    queue.push(0, 1, 4);
+    queue.push(1, 2, 5);
+
+    queue.sort();
+
+    ASSERT_EQ((std::vector<int>{4, 2, 5, 3, 1}), payloads());
+}
+
+TEST_F(RenderQueueTest, should_keep_the_submission_order_of_items_with_equal_keys)
+{
+    std::mt19937 random(7);
+    for (int i = 0; i < 5000; ++i)
+        queue.push(std::uint16_t(random() % 9), std::uint16_t(random() % 700), i);
+
+    queue.sort();
+
+    ASSERT_EQ(5000u, queue.size());
+    for (auto it = queue.begin(), next = it + 1; next != queue.end(); ++it, ++next)
+    {
+        ASSERT_LE(it->key, next->key);
+        ASSERT_TRUE(it->key < next->key || it->payload < next->payload);
+    }
+}
+
+TEST_F(RenderQueueTest, should_decode_bins_and_textures_from_keys)
+{
+    auto key = RenderQueue<int>::key(513, 60000);
+    ASSERT_EQ(513, RenderQueue<int>::bin(key));
+    ASSERT_EQ(60000, RenderQueue<int>::texture(key));
+}
+
+TEST_F(RenderQueueTest, should_sort_an_empty_queue)
+{
+    queue.sort();
+    ASSERT_TRUE(queue.empty());
+    queue.push(1, 1, 1);
+    queue.clear();
+    ASSERT_TRUE(queue.empty());
+}
+
+}
@@ -1,5 +1,6 @@
 #include <ecsps/ResourcePool.hpp>
 #include <gtest/gtest.h>
+#include <stdexcept>
 
 namespace ecsps
 {
@@ -64,4 +65,103 @@ TEST_F(ResourcePoolTest, should_not_fail_when_pointers_expire_after_a_pool_is_de
     ASSERT_TRUE(ref.expired());
 }
 
+TEST_F(ResourcePoolTest, should_load_resources_asynchronously_on_loader_threads)
+{
+    std::atomic<int> created{0};
+    auto loaders = std::make_shared<ThreadPool>(2);
+    struct Release
+    {
+        std::promise<void> promise;
+        bool done = false;
+
+        void operator()()
+        {
+            done = true;
+            promise.set_value();
+        }
+
+        ~Release()
+        {
+            if (!done)
+                promise.set_value();
+        }
+    } release;
+    auto released = release.promise.get_future().share();
+    pool = std::make_shared<ResourcePool<int, Resource>>([&created, released](int id)
+    {
+        released.wait();
+        ++created;
+        return std::make_unique<Resource>(id);
+    }, loaders);
+
+    auto future1 = pool->getAsync(7);
+    auto future2 = pool->getAsync(7);
+    ASSERT_EQ(std::future_status::timeout, future1.wait_for(std::chrono::milliseconds(1)));
+
+    release();
+    auto res = future1.get();
+    ASSERT_EQ(7, res->id);
+    ASSERT_TRUE(res == future2.get());
+    ASSERT_TRUE(res == pool->getAsync(7).get());
+    ASSERT_TRUE(res == pool->get(7));
+    ASSERT_EQ(1, created.load());
+}
+
+#ifndef NDEBUG
+TEST_F(ResourcePoolTest, should_insist_that_the_loader_thread_pool_outlives_it)
+{
+    auto loaders = std::make_shared<ThreadPool>(1);
+    pool = std::make_shared<ResourcePool<int, Resource>>([](int id) { return std::make_unique<Resource>(id); }, loaders);
+    loaders.reset();
+    ASSERT_DEATH(pool->getAsync(3), "outlive|destroyed");
+}
+#endif
+
+TEST_F(ResourcePoolTest, should_run_pending_loads_while_waiting_on_a_loader_thread)
+{
+    auto loaders = std::make_shared<ThreadPool>(1);
+    pool = std::make_shared<ResourcePool<int, Resource>>([](int id) { return std::make_unique<Resource>(id); }, loaders);
+    std::promise<int> result;
+    loaders->submit([&]
+    {
+        auto future = pool->getAsync(5);
+        auto res = pool->get(5);
+        result.set_value(res->id + pool->wait(future)->id);
+    });
+
+    auto sum = result.get_future();
+    ASSERT_EQ(std::future_status::ready, sum.wait_for(std::chrono::seconds(10)));
+    ASSERT_EQ(10, sum.get());
+}
+
+TEST_F(ResourcePoolTest, should_not_hold_the_pool_lock_while_creating_a_resource)
+{
+    std::shared_ptr<const Resource> dependency;
+    pool = std::make_shared<ResourcePool<int, Resource>>([&](int id)
+    {
+        if (id == 1)
+            dependency = pool->get(2);
+        return std::make_unique<Resource>(id);
+    });
+
+    ASSERT_EQ(1, pool->get(1)->id);
+    ASSERT_EQ(2, dependency->id);
+}
+
+TEST_F(ResourcePoolTest, should_report_factory_failures_and_retry_later)
+{
+    bool fail = true;
+    pool = std::make_shared<ResourcePool<int, Resource>>([&](int id)
+    {
+        if (fail)
+            throw std::runtime_error("cannot load");
+        return std::make_unique<Resource>(id);
+    });
+
+    ASSERT_THROW(pool->get(3), std::runtime_error);
+    ASSERT_THROW(pool->getAsync(3).get(), std::runtime_error);
+    fail = false;
+    ASSERT_EQ(3, pool->get(3)->id);
+}
+
 }
@@ -0,0 +1,147 @@
+#include "SceneGenerator.hpp"
+#include "Simulation.hpp"
+#include <ecsps/EntitySystem.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ecsps
+{
+
+struct SceneGeneratorTest : testing::Test
+{
+    using Entities = SimulationComponents<EntitySystem>;
+    using Layout = std::vector<std::tuple<Entity::Index, float, float, std::string, float, float>>;
+
+    static Layout layout(const Entities& es)
+    {
+        Layout entities;
+        es.queryEntities<TransformComponent, SpriteComponent>()([&](Entity entity, const TransformComponent& transform, const SpriteComponent& sprite)
+        {
+            auto velocity = es.find<VelocityComponent>(entity);
+            entities.emplace_back(
+                entity.index, transform.position[0], transform.position[1], sprite.name.str(),
+                velocity ? velocity->velocity[0] : 0, velocity ? velocity->velocity[1] : 0);
+        });
+        return entities;
+    }
+
+    static std::size_t tiles(const Entities& es)
+    {
+        std::size_t count = 0;
+        es.query<SpriteComponent, StaticColliderComponent>()([&](const SpriteComponent& sprite, const StaticColliderComponent& )
+        {
+            count += sprite.name == "tile2"_k;
+        });
+        return count;
+    }
+};
+
+TEST_F(SceneGeneratorTest, should_generate_identical_scenes_for_the_same_seed_and_config)
+{
+    SceneConfig config;
+    config.tiles = 500;
+    config.characters = 50;
+    config.sparsity = 0.3f;
+    config.seed = 42;
+    Entities first, second;
+
+    auto scene1 = generateScene(first, config);
+    auto scene2 = generateScene(second, config);
+
+    ASSERT_EQ(scene1.characters, scene2.characters);
+    ASSERT_EQ(scene1.size, scene2.size);
+    ASSERT_EQ(layout(first), layout(second));
+    ASSERT_EQ((first.view<ColliderComponent, GravityComponent>().size()), (second.view<ColliderComponent, GravityComponent>().size()));
+    ASSERT_EQ(first.view<AnimationComponent>().size(), second.view<AnimationComponent>().size());
+}
+
+TEST_F(SceneGeneratorTest, should_generate_different_scenes_for_different_seeds)
+{
+    SceneConfig config;
+    config.characters = 20;
+    Entities first, second;
+
+    generateScene(first, config);
+    config.seed = 2;
+    generateScene(second, config);
+
+    ASSERT_NE(layout(first), layout(second));
+}
+
+TEST_F(SceneGeneratorTest, should_create_the_requested_tiles_and_fully_equipped_characters)
+{
+    SceneConfig config;
+    config.tiles = 1000;
+    config.characters = 200;
+    Entities es;
+
+    auto scene = generateScene(es, config);
+
+    ASSERT_EQ(1000u, tiles(es));
+    ASSERT_EQ(1016u, scene.staticColliders);
+    ASSERT_EQ(scene.staticColliders, es.view<StaticColliderComponent>().size());
+    ASSERT_EQ(200u, scene.characters.size());
+    ASSERT_EQ(200u, (es.view<TransformComponent, VelocityComponent>().size()));
+    ASSERT_EQ(200u, (es.view<ColliderComponent, GravityComponent, AnimationComponent, CharacterAnimation, CharacterState, MovementInputComponent>().size()));
+    for (auto character : scene.characters)
+        ASSERT_TRUE((es.has<TransformComponent, SpriteComponent, VelocityComponent>(character)));
+}
+
+TEST_F(SceneGeneratorTest, should_leave_out_optional_components_according_to_sparsity)
+{
+    SceneConfig config;
+    config.tiles = 100;
+    config.characters = 2000;
+    config.sparsity = 0.5f;
+    Entities es;
+
+    generateScene(es, config);
+
+    ASSERT_EQ(2000u, (es.view<TransformComponent, VelocityComponent>().size()));
+    for (auto count : {es.view<ColliderComponent>().size(), es.view<GravityComponent>().size(), es.view<AnimationComponent>().size()})
+    {
+        ASSERT_GT(count, 800u);
+        ASSERT_LT(count, 1200u);
+    }
+
+    Entities bare;
+    config.sparsity = 1;
+    generateScene(bare, config);
+    ASSERT_EQ(2000u, (bare.view<TransformComponent, VelocityComponent>().size()));
+    ASSERT_EQ(0u, (bare.view<ColliderComponent>().size()));
+    ASSERT_EQ(0u, (bare.view<GravityComponent>().size()));
+    ASSERT_EQ(0u, (bare.view<AnimationComponent>().size()));
+}
+
+TEST_F(SceneGeneratorTest, should_drive_character_queries_from_character_state)
+{
+    SceneConfig config;
+    config.tiles = 1000;
+    config.characters = 20;
+    Entities es;
+
+    generateScene(es, config);
+
+    auto plan = es.queryPlan<CharacterState, TransformComponent>();
+    ASSERT_EQ(Entities::componentIndex<CharacterState>(), plan.driverComponent);
+    ASSERT_EQ(20u, plan.candidateCount);
+}
+
+TEST_F(SceneGeneratorTest, should_create_no_tiles_when_none_are_requested)
+{
+    SceneConfig config;
+    config.tiles = 0;
+    config.characters = 10;
+    Entities es;
+
+    auto scene = generateScene(es, config);
+
+    ASSERT_EQ(0u, scene.staticColliders);
+    ASSERT_EQ(0u, es.view<StaticColliderComponent>().size());
+    ASSERT_EQ(10u, es.view<VelocityComponent>().size());
+}
+
+}
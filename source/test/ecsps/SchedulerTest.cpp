@@ -0,0 +1,95 @@
+#include <ecsps/EntitySystem.hpp>
+#include <ecsps/Scheduler.hpp>
+#include <gtest/gtest.h>
+
+namespace ecsps
+{
+
+struct SchedulerTest : testing::Test
+{
+    struct A { };
+    struct B { };
+    struct C { };
+    Scheduler<A, B, C> scheduler{std::make_shared<ThreadPool>(4)};
+    std::mutex mutex;
+    std::vector<int> log;
+
+    std::function<void()> record(int id)
+    {
+        return [this, id]
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            log.push_back(id);
+        };
+    }
+
+    std::size_t position(int id) const
+    {
+        return std::find(begin(log), end(log), id) - begin(log);
+    }
+};
+
+TEST_F(SchedulerTest, should_order_systems_only_when_their_component_accesses_conflict)
+{
+    auto writeA = scheduler.add(Reads<>{}, Writes<A>{}, record(0));
+    auto readA = scheduler.add(Reads<A>{}, Writes<>{}, record(1));
+    auto readA2 = scheduler.add(Reads<A>{}, Writes<B>{}, record(2));
+    auto writeC = scheduler.add(Reads<>{}, Writes<C>{}, record(3));
+    auto writeAC = scheduler.add(Reads<>{}, Writes<A, C>{}, record(4));
+
+    ASSERT_EQ((std::vector<std::size_t>{readA, readA2, writeAC}), scheduler.dependents(writeA));
+    ASSERT_EQ((std::vector<std::size_t>{writeAC}), scheduler.dependents(readA));
+    ASSERT_EQ((std::vector<std::size_t>{writeAC}), scheduler.dependents(readA2));
+    ASSERT_EQ((std::vector<std::size_t>{writeAC}), scheduler.dependents(writeC));
+    ASSERT_TRUE(scheduler.dependents(writeAC).empty());
+}
+
+TEST_F(SchedulerTest, should_run_every_system_once_respecting_dependencies)
+{
+    for (int frame = 0; frame < 50; ++frame)
+    {
+        scheduler = Scheduler<A, B, C>{std::make_shared<ThreadPool>(4)};
+        log.clear();
+        scheduler.add(Reads<>{}, Writes<A>{}, record(0));
+        scheduler.add(Reads<A>{}, Writes<B>{}, record(1));
+        scheduler.add(Reads<>{}, Writes<C>{}, record(2));
+        scheduler.add(Reads<B, C>{}, Writes<>{}, record(3));
+        scheduler.add(Reads<A>{}, Writes<>{}, record(4));
+        scheduler.run();
+
+        ASSERT_EQ(5u, log.size());
+        EXPECT_LT(position(0), position(1));
+        EXPECT_LT(position(1), position(3));
+        EXPECT_LT(position(2), position(3));
+        EXPECT_LT(position(0), position(4));
+    }
+}
+
+TEST_F(SchedulerTest, should_run_main_thread_systems_on_the_calling_thread)
+{
+    std::thread::id mainThreadId, anyThreadId;
+    scheduler.add(Reads<>{}, Writes<A>{}, [&] { anyThreadId = std::this_thread::get_id(); });
+    scheduler.add(Reads<A>{}, Writes<>{}, [&] { mainThreadId = std::this_thread::get_id(); }, Affinity::mainThread);
+
+    scheduler.run();
+    scheduler.run();
+
+    ASSERT_EQ(std::this_thread::get_id(), mainThreadId);
+    ASSERT_NE(std::thread::id{}, anyThreadId);
+}
+
+#ifndef NDEBUG
+TEST_F(SchedulerTest, should_reject_writes_to_components_the_running_system_did_not_declare)
+{
+    EntitySystem<A, B, C> es;
+    es.createEntity(A{}, B{});
+    Scheduler<A, B, C> sequential{std::make_shared<ThreadPool>(0)};
+    sequential.add(Reads<B>{}, Writes<A>{}, [&] { es.modify<A, const B>()([](A& , const B& ) { }); });
+    sequential.run();
+
+    sequential.add(Reads<>{}, Writes<C>{}, [&] { es.modify<B>()([](B& ) { }); });
+    ASSERT_DEATH(sequential.run(), "Writes<>");
+}
+#endif
+
+}
@@ -0,0 +1,276 @@
+#include <ecsps/Snapshot.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ecsps_test_query.hpp"
+
+namespace ecsps
+{
+
+namespace
+{
+
+struct Position { float x, y; };
+struct Name { Keyword name; };
+struct Wide { double values[4]; };
+
+void remapKeywords(Name& name, const KeywordRemap& remap)
+{
+    name.name = remap(name.name);
+}
+
+}
+
+template <> struct IsKeywordFree<Position> : std::true_type { };
+template <> struct IsKeywordFree<Wide> : std::true_type { };
+
+struct SnapshotTest : testing::Test
+{
+    using Entities = EntitySystem<Position, Name>;
+    Entities es;
+    std::string path = "ecsps_snapshot_test.bin";
+
+    ~SnapshotTest()
+    {
+        std::remove(path.c_str());
+    }
+
+    std::string readFile()
+    {
+        std::ifstream is(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+    }
+
+    void writeFile(const std::string& contents)
+    {
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+        os << contents;
+    }
+
+    template <typename T>
+    T read(const std::string& contents, std::size_t offset)
+    {
+        T value;
+        std::memcpy(&value, contents.data() + offset, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void patch(std::string& contents, std::size_t offset, T value)
+    {
+        std::memcpy(&contents[offset], &value, sizeof(T));
+    }
+
+    static std::size_t padded(std::size_t offset)
+    {
+        return (offset + 7) / 8 * 8;
+    }
+
+    struct Layout
+    {
+        std::size_t keywordCount = 40;
+        std::size_t signatures;
+        std::size_t positionEntities;
+        std::size_t names;
+    };
+
+    Layout layout(const std::string& contents)
+    {
+        Layout layout;
+        auto slotCount = read<std::uint64_t>(contents, 16);
+        auto freeCount = read<std::uint64_t>(contents, 24);
+        auto keywordCount = read<std::uint64_t>(contents, layout.keywordCount);
+        auto offsets = layout.keywordCount + 8;
+        auto names = offsets + (keywordCount + 1) * 8;
+        layout.signatures = padded(names + read<std::uint64_t>(contents, offsets + keywordCount * 8));
+        auto positions = padded(padded(padded(layout.signatures + slotCount * 8) + slotCount * 4) + freeCount * 4);
+        auto positionCount = read<std::uint64_t>(contents, positions);
+        layout.positionEntities = positions + 8 + positionCount * sizeof(Position);
+        layout.names = padded(layout.positionEntities + positionCount * 4) + 8;
+        return layout;
+    }
+
+    void expectCorruptFileToLeaveTheWorldIntact(const std::string& contents)
+    {
+        writeFile(contents);
+        Entities loaded;
+        auto kept = loaded.createEntity(Position{7, 7}, Name{"kept"_k});
+        auto view = loaded.view<Position, Name>();
+        auto version = loaded.version<Position, Name>();
+        EXPECT_THROW(loadSnapshot(loaded, path), std::runtime_error);
+        EXPECT_TRUE(loaded.alive(kept));
+        EXPECT_EQ(std::vector<float>{7}, positions(loaded));
+        EXPECT_EQ(1u, view.size());
+        EXPECT_EQ(version, (loaded.version<Position, Name>()));
+        EXPECT_EQ(0u, loaded.loadEpoch());
+    }
+
+    std::vector<float> positions(const Entities& entities)
+    {
+        return collectSorted<Position>(entities, [](const Position& p) { return p.x; });
+    }
+};
+
+TEST_F(SnapshotTest, should_restore_components_and_entity_handles)
+{
+    auto a = es.createEntity(Position{1, 2}, Name{"snapshot_a"_k});
+    auto b = es.createEntity(Position{3, 4});
+    auto c = es.createEntity(Name{"snapshot_c"_k});
+    saveSnapshot(es, path);
+
+    Entities loaded;
+    loadSnapshot(loaded, path);
+
+    ASSERT_TRUE(loaded.alive(a));
+    ASSERT_TRUE(loaded.alive(b));
+    ASSERT_TRUE(loaded.alive(c));
+    ASSERT_EQ(2, loaded.get<Position>(a).y);
+    ASSERT_EQ(4, loaded.get<Position>(b).y);
+    ASSERT_TRUE(loaded.get<Name>(a).name == "snapshot_a"_k);
+    ASSERT_TRUE(loaded.get<Name>(c).name == "snapshot_c"_k);
+    ASSERT_FALSE(loaded.has<Name>(b));
+    ASSERT_EQ((std::vector<float>{1, 3}), positions(loaded));
+}
+
+TEST_F(SnapshotTest, should_preserve_generations_and_free_indices)
+{
+    auto a = es.createEntity(Position{1, 1});
+    auto b = es.createEntity(Position{2, 2});
+    es.destroyEntity(a);
+    saveSnapshot(es, path);
+
+    Entities loaded;
+    loaded.createEntity(Position{9, 9});
+    loadSnapshot(loaded, path);
+
+    ASSERT_FALSE(loaded.alive(a));
+    ASSERT_TRUE(loaded.alive(b));
+    auto reused = loaded.createEntity(Position{5, 5});
+    ASSERT_EQ(a.index, reused.index);
+    ASSERT_NE(a.generation, reused.generation);
+    ASSERT_EQ((std::vector<float>{2, 5}), positions(loaded));
+}
+
+TEST_F(SnapshotTest, should_rebuild_groups_after_loading)
+{
+    es.createEntity(Position{1, 1}, Name{"grouped"_k});
+    es.createEntity(Position{2, 2});
+    saveSnapshot(es, path);
+
+    Entities loaded;
+    loaded.createEntity(Position{7, 7}, Name{"stale"_k});
+    ASSERT_EQ(1u, (loaded.view<Position, Name>().size()));
+    loadSnapshot(loaded, path);
+
+    std::vector<float> xs;
+    loaded.query<Position, Name>()([&](const Position& p, const Name& ) { xs.push_back(p.x); });
+    ASSERT_EQ(std::vector<float>{1}, xs);
+}
+
+TEST_F(SnapshotTest, should_keep_existing_views_valid_and_report_the_load)
+{
+    es.createEntity(Position{1, 1}, Name{"kept"_k});
+    es.createEntity(Position{2, 2}, Name{"kept"_k});
+    saveSnapshot(es, path);
+
+    Entities loaded;
+    loaded.createEntity(Position{7, 7}, Name{"stale"_k});
+    auto view = loaded.view<Position, Name>();
+    auto version = loaded.version<Position, Name>();
+    auto epoch = loaded.loadEpoch();
+    loadSnapshot(loaded, path);
+
+    ASSERT_EQ(epoch + 1, loaded.loadEpoch());
+    ASSERT_NE(version, (loaded.version<Position, Name>()));
+    float sum = 0;
+    view([&](const Position& p, const Name& ) { sum += p.x; });
+    ASSERT_EQ(2u, view.size());
+    ASSERT_EQ(3, sum);
+}
+
+TEST_F(SnapshotTest, should_remap_keywords_through_the_string_table)
+{
+    auto entity = es.createEntity(Name{"snapshot_alpha"_k});
+    saveSnapshot(es, path);
+
+    auto contents = readFile();
+    auto at = contents.find("snapshot_alpha");
+    ASSERT_NE(std::string::npos, at);
+    contents.replace(at, 14, "snapshot_omega");
+    writeFile(contents);
+
+    Entities loaded;
+    loadSnapshot(loaded, path);
+    ASSERT_EQ("snapshot_omega", loaded.get<Name>(entity).name.str());
+}
+
+TEST_F(SnapshotTest, should_reject_snapshots_of_a_different_component_layout)
+{
+    es.createEntity(Position{1, 1});
+    saveSnapshot(es, path);
+
+    EntitySystem<Position, Wide> other;
+    ASSERT_THROW(loadSnapshot(other, path), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, should_reject_truncated_snapshots)
+{
+    es.createEntity(Position{1, 1}, Name{"truncated"_k});
+    saveSnapshot(es, path);
+    auto contents = readFile();
+    writeFile(contents.substr(0, contents.size() - 5));
+
+    Entities loaded;
+    ASSERT_THROW(loadSnapshot(loaded, path), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, should_reject_string_tables_larger_than_the_file)
+{
+    es.createEntity(Position{1, 1});
+    saveSnapshot(es, path);
+    auto contents = readFile();
+    patch(contents, layout(contents).keywordCount, std::uint64_t(-1));
+    expectCorruptFileToLeaveTheWorldIntact(contents);
+}
+
+TEST_F(SnapshotTest, should_reject_signatures_that_disagree_with_the_pools)
+{
+    es.createEntity(Position{1, 1});
+    saveSnapshot(es, path);
+    auto contents = readFile();
+    patch(contents, layout(contents).signatures, std::uint64_t(3));
+    expectCorruptFileToLeaveTheWorldIntact(contents);
+}
+
+TEST_F(SnapshotTest, should_reject_duplicate_entities_in_a_pool)
+{
+    es.createEntity(Position{1, 1});
+    es.createEntity(Position{2, 2});
+    saveSnapshot(es, path);
+    auto contents = readFile();
+    auto entities = layout(contents).positionEntities;
+    patch(contents, entities + 4, read<Entity::Index>(contents, entities));
+    expectCorruptFileToLeaveTheWorldIntact(contents);
+}
+
+TEST_F(SnapshotTest, should_reject_keywords_outside_of_the_string_table)
+{
+    es.createEntity(Position{1, 1}, Name{"snapshot_range"_k});
+    saveSnapshot(es, path);
+    auto contents = readFile();
+    patch(contents, layout(contents).names, Keyword::Id(-1));
+    expectCorruptFileToLeaveTheWorldIntact(contents);
+}
+
+TEST_F(SnapshotTest, should_fail_for_missing_files)
+{
+    ASSERT_THROW(loadSnapshot(es, "/nonexistent/ecsps.snapshot"), std::runtime_error);
+}
+
+}
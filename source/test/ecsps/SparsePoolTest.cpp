@@ -0,0 +1,56 @@
+#include <ecsps/SparsePool.hpp>
+#include <gtest/gtest.h>
+
+namespace ecsps
+{
+
+struct SparsePoolTest : testing::Test
+{
+    SparsePool<int> pool;
+
+    std::vector<int> values() const { return {pool.begin(), pool.end()}; }
+};
+
+TEST_F(SparsePoolTest, should_store_components_densely_in_insertion_order)
+{
+    pool.insert(7, 70);
+    pool.insert(2, 20);
+    pool.insert(100, 1000);
+
+    ASSERT_EQ((std::vector<int>{70, 20, 1000}), values());
+    ASSERT_EQ((std::vector<std::uint32_t>{7, 2, 100}), pool.entityIndices());
+    ASSERT_EQ(20, pool.get(2));
+    ASSERT_TRUE(pool.contains(100));
+    ASSERT_FALSE(pool.contains(3));
+    ASSERT_FALSE(pool.contains(1000));
+}
+
+TEST_F(SparsePoolTest, should_replace_a_component_inserted_twice_for_the_same_entity)
+{
+    pool.insert(4, 1);
+    pool.insert(4, 2);
+
+    ASSERT_EQ(1u, pool.size());
+    ASSERT_EQ(2, pool.get(4));
+}
+
+TEST_F(SparsePoolTest, should_erase_by_moving_the_last_component_into_the_hole)
+{
+    pool.insert(1, 10);
+    pool.insert(2, 20);
+    pool.insert(3, 30);
+
+    pool.erase(1);
+
+    ASSERT_EQ((std::vector<int>{30, 20}), values());
+    ASSERT_FALSE(pool.contains(1));
+    ASSERT_EQ(30, pool.get(3));
+    ASSERT_EQ(20, pool.get(2));
+
+    pool.erase(2);
+    pool.erase(2);
+    pool.erase(3);
+    ASSERT_TRUE(pool.empty());
+}
+
+}
@@ -0,0 +1,49 @@
+#include <ecsps/SpatialGrid.hpp>
+#include <gtest/gtest.h>
+
+namespace ecsps
+{
+
+struct SpatialGridTest : testing::Test
+{
+    SpatialGrid<int> grid{10};
+
+    std::vector<int> query(vec2f position, vec2f size)
+    {
+        std::vector<int> found;
+        grid.query(position, size, [&](int value) { found.push_back(value); });
+        return found;
+    }
+};
+
+TEST_F(SpatialGridTest, should_find_only_items_overlapping_the_query_box)
+{
+    grid.insert({0, 0}, {5, 5}, 1);
+    grid.insert({20, 0}, {5, 5}, 2);
+    grid.insert({-30, -30}, {5, 5}, 3);
+
+    ASSERT_EQ((std::vector<int>{1}), query({1, 1}, {1, 1}));
+    ASSERT_EQ((std::vector<int>{2}), query({22, 2}, {10, 1}));
+    ASSERT_EQ((std::vector<int>{3}), query({-28, -28}, {1, 1}));
+    ASSERT_EQ((std::vector<int>{}), query({8, 0}, {10, 10}));
+}
+
+TEST_F(SpatialGridTest, should_report_items_spanning_many_cells_once_in_insertion_order)
+{
+    grid.insert({15, 15}, {5, 5}, 1);
+    grid.insert({0, 0}, {100, 100}, 2);
+    grid.insert({12, 12}, {30, 3}, 3);
+
+    ASSERT_EQ((std::vector<int>{1, 2, 3}), query({0, 0}, {50, 50}));
+}
+
+TEST_F(SpatialGridTest, should_forget_items_when_cleared)
+{
+    grid.insert({0, 0}, {5, 5}, 1);
+    grid.clear();
+
+    ASSERT_EQ(0u, grid.size());
+    ASSERT_EQ((std::vector<int>{}), query({0, 0}, {5, 5}));
+}
+
+}
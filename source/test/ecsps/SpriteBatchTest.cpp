@@ -0,0 +1,88 @@
+#include <ecsps/SpriteBatch.hpp>
+#include <gtest/gtest.h>
+
+namespace ecsps
+{
+
+struct SpriteBatchTest : testing::Test
+{
+    struct Texture { };
+
+    struct RecordingBackend
+    {
+        struct DrawCall
+        {
+            const Texture *texture;
+            std::vector<SpriteVertex> vertices;
+        };
+        std::vector<DrawCall> drawCalls;
+
+        void draw(const Texture& texture, const SpriteVertex *vertices, std::size_t count)
+        {
+            drawCalls.push_back({&texture, {vertices, vertices + count}});
+        }
+    };
+
+    Texture texture1, texture2;
+    SpriteBatch<Texture> batch;
+    RecordingBackend backend;
+
+    static void expectVertex(const SpriteVertex& vertex, vec2f position, vec2f texCoords)
+    {
+        EXPECT_EQ(position, vertex.position);
+        EXPECT_EQ(texCoords, vertex.texCoords);
+    }
+};
+
+TEST_F(SpriteBatchTest, should_emit_one_draw_call_per_texture)
+{
+    batch.add(texture1, {0, 0}, {10, 10}, {0, 0}, false);
+    batch.add(texture2, {0, 0}, {10, 10}, {0, 0}, false);
+    batch.add(texture1, {20, 0}, {10, 10}, {0, 0}, false);
+    ASSERT_EQ(3u, batch.size());
+
+    batch.flush(backend);
+
+    ASSERT_EQ(2u, backend.drawCalls.size());
+    ASSERT_EQ(&texture1, backend.drawCalls[0].texture);
+    ASSERT_EQ(8u, backend.drawCalls[0].vertices.size());
+    ASSERT_EQ(&texture2, backend.drawCalls[1].texture);
+    ASSERT_EQ(4u, backend.drawCalls[1].vertices.size());
+    ASSERT_EQ(0u, batch.size());
+}
+
+TEST_F(SpriteBatchTest, should_emit_quads_mapping_texture_regions)
+{
+    batch.add(texture1, {100, 200}, {10, 20}, {5, 6}, false);
+    batch.flush(backend);
+
+    auto& vertices = backend.drawCalls.at(0).vertices;
+    expectVertex(vertices.at(0), {100, 200}, {5, 6});
+    expectVertex(vertices.at(1), {110, 200}, {15, 6});
+    expectVertex(vertices.at(2), {110, 220}, {15, 26});
+    expectVertex(vertices.at(3), {100, 220}, {5, 26});
+}
+
+TEST_F(SpriteBatchTest, should_flip_texture_coordinates_of_mirrored_sprites)
+{
+    batch.add(texture1, {0, 0}, {10, 20}, {0, 0}, true);
+    batch.flush(backend);
+
+    auto& vertices = backend.drawCalls.at(0).vertices;
+    expectVertex(vertices.at(0), {0, 0}, {10, 0});
+    expectVertex(vertices.at(1), {10, 0}, {0, 0});
+}
+
+TEST_F(SpriteBatchTest, should_start_empty_after_flushing)
+{
+    batch.add(texture1, {0, 0}, {10, 10}, {0, 0}, false);
+    batch.flush(backend);
+    batch.flush(backend);
+    batch.add(texture2, {0, 0}, {10, 10}, {0, 0}, false);
+    batch.flush(backend);
+
+    ASSERT_EQ(2u, backend.drawCalls.size());
+    ASSERT_EQ(&texture2, backend.drawCalls[1].texture);
+}
+
+}
@@ -0,0 +1,73 @@
+#include <ecsps/ThreadPool.hpp>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+
+namespace ecsps
+{
+
+TEST(ThreadPoolTest, parallel_for_should_visit_every_index_exactly_once)
+{
+    ThreadPool pool{4};
+    std::vector<std::atomic<int>> visits(10007);
+    for (auto& v : visits)
+        v = 0;
+
+    pool.parallelFor(visits.size(), 64, [&](std::size_t first, std::size_t last)
+    {
+        for (auto i = first; i != last; ++i)
+            ++visits[i];
+    });
+
+    for (auto& v : visits)
+        ASSERT_EQ(1, v.load());
+}
+
+TEST(ThreadPoolTest, parallel_for_should_run_inline_without_worker_threads)
+{
+    ThreadPool pool{0};
+    std::vector<int> values(100, 1);
+    pool.parallelFor(values.size(), 8, [&](std::size_t first, std::size_t last)
+    {
+        for (auto i = first; i != last; ++i)
+            values[i] *= 2;
+    });
+    ASSERT_EQ(200, std::accumulate(begin(values), end(values), 0));
+}
+
+TEST(ThreadPoolTest, parallel_for_should_finish_all_chunks_before_rethrowing_an_exception)
+{
+    ThreadPool pool{3};
+    std::atomic<int> finished{0};
+    ASSERT_THROW(pool.parallelFor(64, 1, [&](std::size_t first, std::size_t)
+    {
+        if (first % 16 == 5)
+            throw std::runtime_error("chunk failed");
+        ++finished;
+    }), std::runtime_error);
+    ASSERT_EQ(60, finished.load());
+}
+
+TEST(ThreadPoolTest, should_support_nested_parallel_loops)
+{
+    ThreadPool pool{3};
+    std::atomic<int> count{0};
+    pool.parallelFor(16, 1, [&](std::size_t, std::size_t)
+    {
+        pool.parallelFor(100, 10, [&](std::size_t first, std::size_t last) { count += int(last - first); });
+    });
+    ASSERT_EQ(1600, count.load());
+}
+
+TEST(ThreadPoolTest, should_run_submitted_tasks)
+{
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool{2};
+        for (int i = 0; i < 100; ++i)
+            pool.submit([&] { ++count; });
+    }
+    ASSERT_EQ(100, count.load());
+}
+
+}
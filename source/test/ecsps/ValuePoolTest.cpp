@@ -1,5 +1,7 @@
 #include <ecsps/ValuePool.hpp>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 namespace ecsps
 {
@@ -59,4 +61,26 @@ TEST_F(ValuePoolTest, should_not_fail_when_pointers_expire_after_a_pool_is_destr
     ASSERT_TRUE(ref.expired());
 }
 
+TEST_F(ValuePoolTest, should_return_the_same_pointers_for_equal_values_from_many_threads)
+{
+    const int valueCount = 256;
+    std::vector<std::vector<std::shared_ptr<const int>>> results(4);
+    std::vector<std::thread> threads;
+    for (auto& result : results)
+        threads.emplace_back([&]
+        {
+            for (int i = 0; i < valueCount; ++i)
+                result.push_back(pool->get(i));
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int i = 0; i < valueCount; ++i)
+    {
+        ASSERT_EQ(i, *results[0][i]);
+        for (auto& result : results)
+            ASSERT_TRUE(results[0][i] == result[i]);
+    }
+}
+
 }
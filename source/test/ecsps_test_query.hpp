@@ -0,0 +1,19 @@
+#pragma once
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ecsps
+{
+
+template <typename Component, typename... Components, typename EntitySystem, typename Field>
+auto collectSorted(const EntitySystem& es, Field field)
+{
+    std::vector<std::decay_t<decltype(field(std::declval<const Component&>()))>> values;
+    es.template query<Component, Components...>()([&](const Component& first, const auto&...) { values.push_back(field(first)); });
+    std::sort(begin(values), end(values));
+    return values;
+}
+
+}